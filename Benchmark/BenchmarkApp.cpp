@@ -0,0 +1,327 @@
+#include <LumosEngine.h>
+#include <Core/CoreSystem.h>
+#include <Core/OS/FileSystem.h>
+#include <Core/Profiler.h>
+#include <Graphics/API/Renderer.h>
+#include <Platform/Headless/HeadlessWindow.h>
+#include <Utilities/FrameTimeHistory.h>
+#include <jsonhpp/json.hpp>
+
+#include "Scenes/Scene3D.h"
+#include "Scenes/GraphicsScene.h"
+#include "Scenes/SceneModelViewer.h"
+#include "Scenes/Scene2D.h"
+#include "Scenes/MaterialTest.h"
+
+#include <iomanip>
+
+using namespace Lumos;
+
+// Steps Sandbox scenes for a fixed number of frames at a fixed timestep without a window or input,
+// and writes the frame times, the profiler totals of each subsystem and the renderer's per frame stats as JSON,
+// or CSV if the output ends in .csv.
+//
+// Benchmark [--scene Scene3D] [--frames 600] [--warmup 60] [--timestep 16.667] [--api 2] [--output benchmark.json]
+// --scene can be given more than once, all scenes are run when it is left out.
+// --api picks the graphics backend as in Settings.lua, the default is the null renderer so no GPU is needed.
+
+namespace
+{
+	struct BenchmarkOptions
+	{
+		std::vector<String> scenes;
+		u32 frames = 600;
+		u32 warmupFrames = 60;
+		float timeStep = 1000.0f / 60.0f;
+		int renderAPI = static_cast<int>(Graphics::RenderAPI::NONE);
+		String output = "benchmark.json";
+	};
+
+	struct SubsystemResult
+	{
+		String name;
+		double totalTime;
+		u64 calls;
+	};
+
+	// Graphics::RenderStats averaged over the measured frames
+	struct RenderResult
+	{
+		double drawCalls = 0.0;
+		double triangles = 0.0;
+		double visibleObjects = 0.0;
+		double culledObjects = 0.0;
+		double descriptorSetBinds = 0.0;
+		double uniformBytesUploaded = 0.0;
+
+		void Add(const Graphics::RenderStats& stats, u32 frames)
+		{
+			drawCalls += static_cast<double>(stats.drawCalls) / frames;
+			triangles += static_cast<double>(stats.triangles) / frames;
+			visibleObjects += static_cast<double>(stats.visibleObjects) / frames;
+			culledObjects += static_cast<double>(stats.culledObjects) / frames;
+			descriptorSetBinds += static_cast<double>(stats.descriptorSetBinds) / frames;
+			uniformBytesUploaded += static_cast<double>(stats.uniformBytesUploaded) / frames;
+		}
+	};
+
+	struct SceneResult
+	{
+		String name;
+		FrameTimeStats frameTimes;
+		RenderResult render;
+		std::vector<SubsystemResult> subsystems;
+	};
+
+	const char* const SceneNames[] = { "Scene3D", "GraphicsScene", "Scene2D", "MaterialTest", "SceneModelViewer" };
+
+	bool ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const String arg = argv[i];
+			if (i + 1 >= argc)
+			{
+				Debug::Log::Error("Missing value for {0}", arg);
+				return false;
+			}
+
+			const String value = argv[++i];
+			if (arg == "--scene")
+				options.scenes.push_back(value);
+			else if (arg == "--frames")
+				options.frames = static_cast<u32>(std::stoul(value));
+			else if (arg == "--warmup")
+				options.warmupFrames = static_cast<u32>(std::stoul(value));
+			else if (arg == "--timestep")
+				options.timeStep = std::stof(value);
+			else if (arg == "--api")
+				options.renderAPI = std::stoi(value);
+			else if (arg == "--output")
+				options.output = value;
+			else
+			{
+				Debug::Log::Error("Unknown option {0}", arg);
+				return false;
+			}
+		}
+
+		if (options.scenes.empty())
+			options.scenes.assign(std::begin(SceneNames), std::end(SceneNames));
+
+		return options.frames > 0 && options.timeStep > 0.0f;
+	}
+
+	String WriteJson(const BenchmarkOptions& options, const std::vector<SceneResult>& results)
+	{
+		nlohmann::json json;
+		json["frames"] = options.frames;
+		json["warmupFrames"] = options.warmupFrames;
+		json["timeStep"] = options.timeStep;
+		json["scenes"] = nlohmann::json::array();
+
+		for (auto& result : results)
+		{
+			nlohmann::json scene;
+			scene["name"] = result.name;
+			scene["frameTime"] = {
+				{ "average", result.frameTimes.average },
+				{ "p50", result.frameTimes.p50 },
+				{ "p95", result.frameTimes.p95 },
+				{ "p99", result.frameTimes.p99 },
+				{ "max", result.frameTimes.max }
+			};
+			scene["render"] = {
+				{ "drawCalls", result.render.drawCalls },
+				{ "triangles", result.render.triangles },
+				{ "visibleObjects", result.render.visibleObjects },
+				{ "culledObjects", result.render.culledObjects },
+				{ "descriptorSetBinds", result.render.descriptorSetBinds },
+				{ "uniformBytesUploaded", result.render.uniformBytesUploaded }
+			};
+
+			scene["subsystems"] = nlohmann::json::array();
+			for (auto& subsystem : result.subsystems)
+			{
+				scene["subsystems"].push_back({
+					{ "name", subsystem.name },
+					{ "totalTime", subsystem.totalTime },
+					{ "timePerFrame", subsystem.totalTime / options.frames },
+					{ "callsPerFrame", static_cast<double>(subsystem.calls) / options.frames }
+				});
+			}
+
+			json["scenes"].push_back(scene);
+		}
+
+		return json.dump(4);
+	}
+
+	String WriteCsv(const BenchmarkOptions& options, const std::vector<SceneResult>& results)
+	{
+		// One row per scene and metric, times in milliseconds. Render stats only fill the per frame column.
+		std::stringstream csv;
+		csv << std::fixed << std::setprecision(4);
+		csv << "scene,name,time_per_frame,calls_per_frame\n";
+
+		for (auto& result : results)
+		{
+			csv << result.name << ",frame.average," << result.frameTimes.average << ",1\n";
+			csv << result.name << ",frame.p50," << result.frameTimes.p50 << ",1\n";
+			csv << result.name << ",frame.p95," << result.frameTimes.p95 << ",1\n";
+			csv << result.name << ",frame.p99," << result.frameTimes.p99 << ",1\n";
+			csv << result.name << ",frame.max," << result.frameTimes.max << ",1\n";
+
+			csv << result.name << ",render.drawCalls,," << result.render.drawCalls << "\n";
+			csv << result.name << ",render.triangles,," << result.render.triangles << "\n";
+			csv << result.name << ",render.visibleObjects,," << result.render.visibleObjects << "\n";
+			csv << result.name << ",render.culledObjects,," << result.render.culledObjects << "\n";
+			csv << result.name << ",render.descriptorSetBinds,," << result.render.descriptorSetBinds << "\n";
+			csv << result.name << ",render.uniformBytesUploaded,," << result.render.uniformBytesUploaded << "\n";
+
+			for (auto& subsystem : result.subsystems)
+				csv << result.name << "," << subsystem.name << "," << subsystem.totalTime / options.frames << "," << static_cast<double>(subsystem.calls) / options.frames << "\n";
+		}
+
+		return csv.str();
+	}
+}
+
+class BenchmarkApp : public Application
+{
+public:
+	BenchmarkApp(const WindowProperties& windowProperties, const BenchmarkOptions& options)
+		: Application(windowProperties)
+		, m_Options(options)
+		, m_Time(0.0f)
+	{
+	}
+
+	void Init() override
+	{
+		Application::Init();
+
+		const String root = ROOT_DIR;
+		VFS::Get()->Mount("Meshes", root + "/Sandbox/res/meshes");
+		VFS::Get()->Mount("Textures", root + "/Sandbox/res/textures");
+		VFS::Get()->Mount("Sounds", root + "/Sandbox/res/sounds");
+
+		GetSceneManager()->EnqueueScene<Scene3D>("Scene3D");
+		GetSceneManager()->EnqueueScene<GraphicsScene>("GraphicsScene");
+		GetSceneManager()->EnqueueScene<Scene2D>("Scene2D");
+		GetSceneManager()->EnqueueScene<MaterialTest>("MaterialTest");
+		GetSceneManager()->EnqueueScene<SceneModelViewer>("SceneModelViewer");
+
+		// Particles aren't attached to any scene yet, a fixed set of emitters is stepped alongside every scene
+		for (int i = 0; i < 16; ++i)
+		{
+			auto emitter = CreateRef<ParticleEmitter>();
+			emitter->SetPosition(Maths::Vector3(static_cast<float>(i), 0.0f, 0.0f));
+			m_Particles.Add(emitter);
+		}
+	}
+
+	bool RunBenchmark()
+	{
+		std::vector<SceneResult> results;
+		for (auto& name : m_Options.scenes)
+		{
+			GetSceneManager()->SwitchScene(name);
+			if (!GetSceneManager()->GetSwitchingScene())
+				return false;
+
+			GetSceneManager()->ApplySceneSwitch();
+			GetSystem<LumosPhysicsEngine>()->SetPaused(false);
+			GetSystem<B2PhysicsEngine>()->SetPaused(false);
+
+			results.push_back(RunScene(name));
+		}
+
+		const bool csv = StringEndsWith(m_Options.output, ".csv");
+		if (!FileSystem::WriteTextFile(m_Options.output, csv ? WriteCsv(m_Options, results) : WriteJson(m_Options, results)))
+		{
+			Debug::Log::Error("Failed to write benchmark results to {0}", m_Options.output);
+			return false;
+		}
+
+		Debug::Log::Info("Benchmark results written to {0}", m_Options.output);
+		return true;
+	}
+
+private:
+	SceneResult RunScene(const String& name)
+	{
+		Debug::Log::Info("Benchmarking {0} for {1} frames", name, m_Options.frames);
+
+		auto profiler = Profiler::Instance();
+
+		for (u32 i = 0; i < m_Options.warmupFrames; ++i)
+			Step();
+
+		profiler->Flush();
+		profiler->ClearHistory();
+
+		// Wall time of each frame, the simulation itself always advances by the fixed timestep
+		SceneResult result;
+		result.name = name;
+
+		FrameTimeHistory frameTimes(m_Options.frames);
+		for (u32 i = 0; i < m_Options.frames; ++i)
+		{
+			const i64 start = Profiler::Now();
+			Step();
+			frameTimes.Add(static_cast<float>(Profiler::Now() - start) / 1000000.0f);
+			result.render.Add(Graphics::Renderer::GetRenderStats(), m_Options.frames);
+		}
+
+		profiler->Flush();
+
+		result.frameTimes = frameTimes.CalculateStats();
+
+		for (auto& action : profiler->GenerateReport().actions)
+			result.subsystems.push_back({ action.name, action.duration, action.calls });
+
+		std::sort(result.subsystems.begin(), result.subsystems.end(), [](const SubsystemResult& a, const SubsystemResult& b) { return a.totalTime > b.totalTime; });
+		return result;
+	}
+
+	void Step()
+	{
+		m_Time += m_Options.timeStep;
+		m_Particles.Update(m_Options.timeStep * 0.001f);
+		StepFrame(m_Time);
+	}
+
+	static bool StringEndsWith(const String& string, const String& end)
+	{
+		return string.size() >= end.size() && string.compare(string.size() - end.size(), end.size(), end) == 0;
+	}
+
+	BenchmarkOptions m_Options;
+	float m_Time;
+	ParticleManager m_Particles;
+};
+
+int main(int argc, char** argv)
+{
+	Lumos::Internal::CoreSystem::Init(true);
+
+	BenchmarkOptions options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		Lumos::Internal::CoreSystem::Shutdown();
+		return 1;
+	}
+
+	HeadlessWindow::MakeDefault();
+
+	WindowProperties windowProperties(1280, 720, options.renderAPI, "Benchmark", false, false);
+	auto app = new BenchmarkApp(windowProperties, options);
+	app->Init();
+	const bool success = app->RunBenchmark();
+	delete app;
+
+	Lumos::Internal::CoreSystem::Shutdown();
+
+	return success ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+project "Benchmark"
+	kind "ConsoleApp"
+	language "C++"
+
+	files
+	{
+		"**.h",
+		"**.cpp",
+		"../Sandbox/Scenes/**.h",
+		"../Sandbox/Scenes/**.cpp"
+	}
+
+	sysincludedirs
+	{
+		"../Lumos/external/spdlog/include",
+		"../Lumos/external/",
+		"../Lumos/external/stb/",
+		"../Dependencies/lua/src/",
+		"../Dependencies/glfw/include/",
+		"../Dependencies/glad/include/",
+		"../Dependencies/OpenAL/include/",
+		"../Dependencies/stb/",
+		"../Dependencies/Box2D/",
+		"../Dependencies/vulkan/",
+		"../Dependencies/",
+		"../Lumos/external/",
+		"../Lumos/external/jsonhpp/",
+		"../Lumos/external/spdlog/include",
+        "../Lumos/src",
+        "../Sandbox"
+	}
+
+	links
+	{
+		"Lumos",
+		"lua",
+		"Box2D",
+		"volk",
+		"imgui"
+	}
+
+	cwd = os.getcwd() .. "/.."
+
+	defines
+	{
+		--"LUMOS_DYNAMIC",
+        "LUMOS_ROOT_DIR="  .. cwd
+	}
+
+	filter "system:windows"
+		cppdialect "C++17"
+		staticruntime "On"
+		systemversion "latest"
+
+		defines
+		{
+			"LUMOS_PLATFORM_WINDOWS",
+			"LUMOS_RENDER_API_OPENGL",
+			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
+			"VK_USE_PLATFORM_WIN32_KHR",
+			"WIN32_LEAN_AND_MEAN",
+			"_CRT_SECURE_NO_WARNINGS",
+			"_DISABLE_EXTENDED_ALIGNED_STORAGE"
+		}
+
+		buildoptions
+		{
+			"/MP"
+		}
+
+		links
+		{
+			"glfw",
+			"glad",
+		}
+
+	filter "system:macosx"
+		cppdialect "C++17"
+		staticruntime "On"
+		systemversion "latest"
+
+		defines
+		{
+			"LUMOS_PLATFORM_MACOS",
+			"LUMOS_PLATFORM_UNIX",
+			"LUMOS_RENDER_API_OPENGL",
+			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
+			"VK_USE_PLATFORM_MACOS_MVK",
+			"LUMOS_IMGUI"
+		}
+
+		linkoptions 
+		{ 
+			"-framework OpenGL",
+			"-framework Cocoa",
+			"-framework IOKit", 
+			"-framework CoreVideo",
+			"-framework OpenAL",
+			"-framework QuartzCore"
+		}
+
+		links
+		{
+			"glfw",
+			"glad"
+		}
+
+		filter {"system:macosx", "configurations:release"}
+
+			local source = "../Dependencies/vulkan/libs/macOS/**"
+			local target = "../bin/release/"
+			
+			buildmessage("copying "..source.." -> "..target)
+			
+			postbuildcommands {
+				"{COPY} "..source.." "..target
+			}
+
+		filter {"system:macosx", "configurations:dist"}
+
+			local source = "../Dependencies/vulkan/libs/macOS/**"
+			local target = "../bin/dist/"
+			
+			buildmessage("copying "..source.." -> "..target)
+			
+			postbuildcommands {
+				"{COPY} "..source.." "..target
+			}
+
+		filter {"system:macosx", "configurations:debug"}
+
+			local source = "../Dependencies/vulkan/libs/macOS/**"
+			local target = "../bin/debug/"
+			
+			buildmessage("copying "..source.." -> "..target)
+			
+			postbuildcommands {
+				"{COPY} "..source.." "..target
+			}
+
+	filter "system:linux"
+		cppdialect "C++17"
+		staticruntime "On"
+		systemversion "latest"
+
+		defines
+		{
+			"LUMOS_PLATFORM_LINUX",
+			"LUMOS_PLATFORM_UNIX",
+			"LUMOS_RENDER_API_OPENGL",
+			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
+			"VK_USE_PLATFORM_XCB_KHR",
+			"LUMOS_IMGUI"
+		}
+
+		buildoptions
+		{
+			"-msse4.1",
+			"-fpermissive",
+			"-Wattributes",
+			"-fPIC",
+			"-Wignored-attributes"
+		}
+
+		links
+		{
+			"glfw",
+			"glad"
+		}
+
+		links { "X11", "pthread"}
+
+		linkoptions
+		{
+			"-L%{cfg.targetdir}"
+		}
+
+		linkoptions{ "-Wl,-rpath=\\$$ORIGIN" }
+
+	filter "configurations:Debug"
+		defines "LUMOS_DEBUG"
+		symbols "On"
+		runtime "Debug"
+
+	filter "configurations:Release"
+		defines "LUMOS_RELEASE"
+		optimize "On"
+		symbols "On"
+		runtime "Release"
+
+	filter "configurations:Dist"
+		defines "LUMOS_DIST"
+		optimize "On"
+		runtime "Release"
\ No newline at end of file
@@ -70,6 +70,7 @@ project "Lumos"
 			--"LUMOS_BUILD_DLL",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_WIN32_KHR",
 			"WIN32_LEAN_AND_MEAN",
 			"_CRT_SECURE_NO_WARNINGS",
@@ -87,6 +88,12 @@ project "Lumos"
 			"src/Platform/GLFW/*.h",
 			"src/Platform/GLFW/*.cpp",
 
+			"src/Platform/Headless/*.h",
+			"src/Platform/Headless/*.cpp",
+
+			"src/Platform/Null/*.h",
+			"src/Platform/Null/*.cpp",
+
 			"src/Platform/OpenAL/*.h",
 			"src/Platform/OpenAL/*.cpp",
 
@@ -131,6 +138,12 @@ project "Lumos"
 			"src/Platform/GLFW/*.h",
 			"src/Platform/GLFW/*.cpp",
 
+			"src/Platform/Headless/*.h",
+			"src/Platform/Headless/*.cpp",
+
+			"src/Platform/Null/*.h",
+			"src/Platform/Null/*.cpp",
+
 			"src/Platform/OpenAL/*.h",
 			"src/Platform/OpenAL/*.cpp",
 
@@ -147,6 +160,7 @@ project "Lumos"
 			"LUMOS_PLATFORM_UNIX",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_METAL_EXT",
 			"LUMOS_IMGUI",
 			"LUMOS_OPENAL"
@@ -259,6 +273,7 @@ project "Lumos"
 			"LUMOS_PLATFORM_UNIX",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_XCB_KHR",
 			"LUMOS_IMGUI"
 		}
@@ -271,6 +286,12 @@ project "Lumos"
 			"src/Platform/GLFW/*.h",
 			"src/Platform/GLFW/*.cpp",
 
+			"src/Platform/Headless/*.h",
+			"src/Platform/Headless/*.cpp",
+
+			"src/Platform/Null/*.h",
+			"src/Platform/Null/*.cpp",
+
 			"src/Platform/OpenAL/*.h",
 			"src/Platform/OpenAL/*.cpp",
 
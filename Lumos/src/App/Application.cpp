@@ -18,6 +18,9 @@
 #include "Core/OS/Window.h"
 #include "Core/Profiler.h"
 #include "Core/VFS.h"
+#include "Core/JobSystem.h"
+#include "Core/OS/Allocators/FrameAllocator.h"
+#include "Core/OS/MemoryManager.h"
 
 #include "ImGui/ImGuiLayer.h"
 
@@ -167,28 +170,7 @@ namespace Lumos
 		{
 			m_UpdateTimer += Engine::Instance()->TargetFrameRate();
 #endif
-
-            Profiler::Instance()->Update(now);
-            Engine::GetTimeStep()->Update(now);
-
-			{
-                LUMOS_PROFILE_BLOCK("Application::Update");
-				OnUpdate(Engine::GetTimeStep());
-				m_Updates++;
-			}
-
-			if(!m_Minimized)
-			{
-                LUMOS_PROFILE_BLOCK("Application::Render");
-				OnRender();
-				m_Frames++;
-			}
-
-			Input::GetInput()->ResetPressed();
-			m_Window->OnUpdate();
-
-			if (Input::GetInput()->GetKeyPressed(LUMOS_KEY_ESCAPE))
-				m_CurrentState = AppState::Closing;
+			StepFrame(now);
 #ifdef LUMOS_LIMIT_FRAMERATE
 		}
 #endif
@@ -216,8 +198,40 @@ namespace Lumos
 		return m_CurrentState != AppState::Closing;
 	}
 
+	void Application::StepFrame(float now)
+	{
+		Profiler::Instance()->Update(now);
+		Engine::GetTimeStep()->Update(now);
+		Engine::Instance()->GetFrameTimes().Add(Engine::GetTimeStep()->GetMillis());
+
+		{
+			LUMOS_PROFILE_BLOCK("Application::Update");
+			OnUpdate(Engine::GetTimeStep());
+			m_Updates++;
+		}
+
+		if(!m_Minimized)
+		{
+			LUMOS_PROFILE_BLOCK("Application::Render");
+			OnRender();
+			m_Frames++;
+		}
+
+		Input::GetInput()->ResetPressed();
+		m_Window->OnUpdate();
+
+		System::JobSystem::OnFrameEnd();
+		FrameAllocator::OnFrameEnd();
+		MemoryManager::OnFrameEnd();
+
+		if (Input::GetInput()->GetKeyPressed(LUMOS_KEY_ESCAPE))
+			m_CurrentState = AppState::Closing;
+	}
+
 	void Application::OnRender()
 	{
+		LUMOS_MEMORY_TAG(Renderer);
+
 		if (m_LayerStack->GetCount() > 0)
 		{
 			Graphics::Renderer::GetRenderer()->Begin();
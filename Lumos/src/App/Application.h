@@ -75,6 +75,8 @@ namespace Lumos
 
 		void Run();
 		bool OnFrame();
+		// One update and render with the clock at now milliseconds, OnFrame calls it with the real time
+		void StepFrame(float now);
 		void OnUpdate(TimeStep* dt);
 		void OnRender();
 		void OnEvent(Event& e);
@@ -1,6 +1,7 @@
 #pragma once
 #include "lmpch.h"
 #include "Utilities/TimeStep.h"
+#include "Utilities/FrameTimeHistory.h"
 #include "Utilities/TSingleton.h"
 
 namespace Lumos
@@ -25,6 +26,10 @@ namespace Lumos
         
         static TimeStep* GetTimeStep() { return Engine::Instance()->m_TimeStep; }
 
+        // Time of every rendered frame, unlike GetFrametime which is averaged over a second
+        FrameTimeHistory& GetFrameTimes() { return m_FrameTimes; }
+        const FrameTimeHistory& GetFrameTimes() const { return m_FrameTimes; }
+
     private:
 
         u32  m_UpdatesPerSecond;
@@ -33,5 +38,6 @@ namespace Lumos
         float m_MaxFramesPerSecond;
         
         TimeStep* m_TimeStep;
+        FrameTimeHistory m_FrameTimes;
     };
 }
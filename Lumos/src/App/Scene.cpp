@@ -72,6 +72,10 @@ namespace Lumos
 #ifdef LUMOS_RENDER_API_DIRECT3D
 		case DIRECT3D: RenderAPI = "Direct3D"; break;
 #endif
+
+#ifdef LUMOS_RENDER_API_NONE
+		case Graphics::RenderAPI::NONE: RenderAPI = "None"; break;
+#endif
 		}
 
 		std::stringstream Title;
@@ -1,6 +1,9 @@
 #include "lmpch.h"
 #include "SceneGraph.h"
 #include "Maths/Transform.h"
+#include "Maths/TransformStore.h"
+#include "Core/Profiler.h"
+#include "Core/JobSystem.h"
 
 namespace Lumos
 {
@@ -13,53 +16,285 @@ namespace Lumos
 		registry.on_construct<Hierarchy>().connect<&Hierarchy::on_construct>();
 		registry.on_replace<Hierarchy>().connect<&Hierarchy::on_replace>();
 		registry.on_destroy<Hierarchy>().connect<&Hierarchy::on_destroy>();
+
+		// Live SoATransforms point into the store, only create it once per registry
+		if (!registry.try_ctx<Maths::TransformStore>())
+			registry.set<Maths::TransformStore>();
+		registry.on_construct<Maths::SoATransform>().connect<&Maths::SoATransform::on_construct>();
+		registry.on_replace<Maths::SoATransform>().connect<&Maths::SoATransform::on_replace>();
+		registry.on_destroy<Maths::SoATransform>().connect<&Maths::SoATransform::on_destroy>();
+
+		// Live Hierarchy::_index values point into the layout, only build it once per registry
+		if (registry.try_ctx<HierarchyLayout>())
+			return;
+
+		auto& layout = registry.set<HierarchyLayout>();
+		// Hierarchies created before Init may have been assigned without the callbacks, rebuild their child lists from _parent
+		auto view = registry.view<Hierarchy>();
+		for (auto entity : view)
+		{
+			auto& hierarchy = view.get(entity);
+			hierarchy._first = hierarchy._last = hierarchy._next = hierarchy._prev = entt::null;
+			hierarchy._index = HierarchyLayout::Invalid;
+		}
+
+		for (auto entity : view)
+		{
+			auto& hierarchy = view.get(entity);
+			const auto parent = hierarchy._parent;
+			if (parent == entt::null || !registry.valid(parent) || !registry.has<Hierarchy>(parent))
+				continue;
+
+			auto& parentHierarchy = view.get(parent);
+			if (parentHierarchy._first == entt::null)
+			{
+				parentHierarchy._first = entity;
+			}
+			else
+			{
+				view.get(parentHierarchy._last)._next = entity;
+				hierarchy._prev = parentHierarchy._last;
+			}
+			parentHierarchy._last = entity;
+		}
+
+		// Laid out parent first from each root
+		std::vector<entt::entity> stack;
+		for (auto entity : view)
+		{
+			const auto parent = view.get(entity)._parent;
+			if (parent != entt::null && registry.valid(parent) && registry.has<Hierarchy>(parent))
+				continue;
+
+			stack.push_back(entity);
+			while (!stack.empty())
+			{
+				const auto current = stack.back();
+				stack.pop_back();
+				layout.Insert(current, registry);
+
+				for (auto child = view.get(current)._first; child != entt::null; child = view.get(child)._next)
+					stack.push_back(child);
+			}
+		}
 	}
 
 	void SceneGraph::Update(entt::registry & registry)
     {
+		LUMOS_PROFILE_BLOCK("SceneGraph::Update");
+
+		// SoA transforms have no parent, only their own TRS feeds the world matrix
+		registry.ctx<Maths::TransformStore>().UpdateWorldMatrices();
+
 		auto view = registry.view<Maths::Transform>();
 
 		if (view.empty())
 			return;
 
-		for (auto entity : view)
+		auto& layout = registry.ctx<HierarchyLayout>();
+		const auto nodes = layout.GetNodes().data();
+		const auto worldMatrices = layout.GetWorldMatrices().data();
+
+		// Transforms outside any hierarchy are roots, the rest are flagged in the layout
+		const auto entities = view.data();
+		const auto transforms = view.raw();
+		System::JobSystem::ParallelForChunked(0, static_cast<u32>(view.size()), [&registry, entities, transforms, nodes](u32 begin, u32 end)
 		{
-			const auto hierarchy = registry.try_get<Hierarchy>(entity);
-			if (hierarchy && hierarchy->parent() != entt::null)
+			for (u32 i = begin; i < end; i++)
 			{
-				UpdateTransform(entity, registry);
+				auto& transform = transforms[i];
+				if (!transform.IsDirty())
+					continue;
+
+				auto hierarchy = registry.try_get<Hierarchy>(entities[i]);
+				if (hierarchy && hierarchy->_index != HierarchyLayout::Invalid)
+				{
+					nodes[hierarchy->_index].dirty = true;
+				}
+				else
+				{
+					transform.SetWorldMatrix(Maths::Matrix4::IDENTITY);
+					transform.SetHasUpdated(false);
+				}
 			}
-			else
+		});
+
+		// Nodes of one level only read the level above, so the levels run in order and each level runs in parallel
+		for (u32 level = 0; level < layout.GetLevelCount(); level++)
+		{
+			System::JobSystem::ParallelForChunked(layout.GetLevelBegin(level), layout.GetLevelEnd(level), [&registry, nodes, worldMatrices](u32 begin, u32 end)
 			{
-				registry.get<Maths::Transform>(entity).SetWorldMatrix(Maths::Matrix4());
-			}
+				for (u32 i = begin; i < end; i++)
+				{
+					auto& node = nodes[i];
+					// An external parent's changes aren't tracked by the layout, so those nodes update every frame
+					node.updated = node.dirty || node.external != entt::null || (node.parent != HierarchyLayout::Invalid && nodes[node.parent].updated);
+					node.dirty = false;
+					if (!node.updated)
+						continue;
+
+					const Maths::Matrix4* parentWorld = &Maths::Matrix4::IDENTITY;
+					if (node.parent != HierarchyLayout::Invalid)
+					{
+						parentWorld = &worldMatrices[node.parent];
+					}
+					else if (node.external != entt::null && registry.valid(node.external) && !registry.has<Hierarchy>(node.external))
+					{
+						// Outside the layout, so its world matrix was already set by the scan above
+						auto parentTransform = registry.try_get<Maths::Transform>(node.external);
+						if (parentTransform)
+							parentWorld = &parentTransform->GetWorldMatrix();
+					}
+
+					auto transform = registry.try_get<Maths::Transform>(node.entity);
+					if (transform)
+					{
+						transform->SetWorldMatrix(*parentWorld);
+						transform->SetHasUpdated(false);
+						worldMatrices[i] = transform->GetWorldMatrix();
+					}
+					else
+					{
+						// Nodes without a transform pass their parent's world matrix on
+						worldMatrices[i] = *parentWorld;
+					}
+				}
+			});
 		}
     }
 
-	void SceneGraph::UpdateTransform(entt::entity entity, entt::registry & registry)
+	// Reparenting changes the world matrix even though the local transform is the same
+	static void MarkTransformDirty(entt::entity entity, entt::registry& registry)
+	{
+		auto transform = registry.try_get<Maths::Transform>(entity);
+		if (transform)
+			transform->SetHasUpdated(true);
+	}
+
+	u32 HierarchyLayout::GetLevel(u32 index) const
 	{
-		auto hierarchyComponent = registry.try_get<Hierarchy>(entity);
-		if (hierarchyComponent)
+		return static_cast<u32>(std::upper_bound(m_LevelOffsets.begin(), m_LevelOffsets.end(), index) - m_LevelOffsets.begin()) - 1;
+	}
+
+	void HierarchyLayout::MoveNode(u32 from, u32 to, entt::registry& registry)
+	{
+		m_Nodes[to] = m_Nodes[from];
+		m_WorldMatrices[to] = m_WorldMatrices[from];
+
+		auto& hierarchy = registry.get<Hierarchy>(m_Nodes[to].entity);
+		hierarchy._index = to;
+
+		entt::entity child = hierarchy._first;
+		while (child != entt::null)
+		{
+			auto& childHierarchy = registry.get<Hierarchy>(child);
+			if (childHierarchy._index != Invalid)
+				m_Nodes[childHierarchy._index].parent = to;
+			child = childHierarchy._next;
+		}
+	}
+
+	void HierarchyLayout::Insert(entt::entity entity, entt::registry& registry)
+	{
+		u32 parentIndex = Invalid;
+		entt::entity external = entt::null;
+		u32 level = 0;
+
+		auto& hierarchy = registry.get<Hierarchy>(entity);
+		if (hierarchy._parent != entt::null && registry.valid(hierarchy._parent))
 		{
-			auto transform = registry.try_get<Maths::Transform>(entity);
-			if (transform && hierarchyComponent->parent() != entt::null)
+			auto parentHierarchy = registry.try_get<Hierarchy>(hierarchy._parent);
+			if (parentHierarchy && parentHierarchy->_index != Invalid)
 			{
-				auto parentTransform = registry.try_get<Maths::Transform>(hierarchyComponent->parent());
-				if (parentTransform)
-				{
-					transform->SetWorldMatrix(parentTransform->GetWorldMatrix());
-				}
+				parentIndex = parentHierarchy->_index;
+				level = GetLevel(parentIndex) + 1;
 			}
+			else
+			{
+				external = hierarchy._parent;
+			}
+		}
 
-			entt::entity child = hierarchyComponent->first();
-			while (child != entt::null)
+		if (level == GetLevelCount())
+			m_LevelOffsets.push_back(m_LevelOffsets.back());
+
+		// Open a slot at the end of the level by moving the first node of each deeper level to its end
+		u32 slot = static_cast<u32>(m_Nodes.size());
+		m_Nodes.emplace_back();
+		m_WorldMatrices.emplace_back();
+		m_LevelOffsets.back()++;
+
+		for (u32 i = GetLevelCount() - 1; i > level; i--)
+		{
+			const u32 first = m_LevelOffsets[i];
+			if (first != slot)
+				MoveNode(first, slot, registry);
+			slot = first;
+			m_LevelOffsets[i]++;
+		}
+
+		auto& node = m_Nodes[slot];
+		node.entity = entity;
+		node.parent = parentIndex;
+		node.external = external;
+		node.dirty = true;
+		node.updated = false;
+		hierarchy._index = slot;
+
+		// Reinsert existing children so the subtree moves to its new depth
+		entt::entity child = hierarchy._first;
+		while (child != entt::null)
+		{
+			auto& childHierarchy = registry.get<Hierarchy>(child);
+			auto next = childHierarchy._next;
+			if (childHierarchy._index != Invalid)
+			{
+				Remove(child, registry);
+				Insert(child, registry);
+			}
+			child = next;
+		}
+	}
+
+	void HierarchyLayout::Remove(entt::entity entity, entt::registry& registry)
+	{
+		auto& hierarchy = registry.get<Hierarchy>(entity);
+		if (hierarchy._index == Invalid)
+			return;
+
+		// Children keep their depth and still follow this entity's Transform, same as before the layout
+		entt::entity child = hierarchy._first;
+		while (child != entt::null)
+		{
+			auto& childHierarchy = registry.get<Hierarchy>(child);
+			if (childHierarchy._index != Invalid)
 			{
-				auto hierarchyComponent = registry.try_get<Hierarchy>(child);
-				auto next = hierarchyComponent ? hierarchyComponent->next() : entt::null;
-				UpdateTransform(child, registry);
-				child = next;
+				auto& childNode = m_Nodes[childHierarchy._index];
+				childNode.parent = Invalid;
+				childNode.external = entity;
+				childNode.dirty = true;
 			}
+			child = childHierarchy._next;
 		}
+
+		u32 hole = hierarchy._index;
+		hierarchy._index = Invalid;
+
+		// Fill the hole with the last node of its level, then move it to the end one level at a time
+		for (u32 i = GetLevel(hole); i < GetLevelCount(); i++)
+		{
+			const u32 last = m_LevelOffsets[i + 1] - 1;
+			if (last != hole)
+				MoveNode(last, hole, registry);
+			hole = last;
+			m_LevelOffsets[i + 1]--;
+		}
+
+		m_Nodes.pop_back();
+		m_WorldMatrices.pop_back();
+
+		while (GetLevelCount() > 0 && m_LevelOffsets[GetLevelCount() - 1] == m_LevelOffsets.back())
+			m_LevelOffsets.pop_back();
 	}
 
 	void Hierarchy::Reparent(entt::entity entity, entt::entity parent, entt::registry& registry, Hierarchy& hierarchy)
@@ -96,9 +331,20 @@ namespace Lumos
 
 	void Hierarchy::on_construct(entt::entity entity, entt::registry& registry, Hierarchy& hierarchy)
 	{
+		MarkTransformDirty(entity, registry);
+
+		hierarchy._prev = entt::null;
+		hierarchy._next = entt::null;
+		hierarchy._index = HierarchyLayout::Invalid;
+
 		if (hierarchy._parent != entt::null)
 		{
-			auto& parent_hierarchy = registry.get_or_assign<Hierarchy>(hierarchy._parent);
+			const auto parent = hierarchy._parent;
+			registry.get_or_assign<Hierarchy>(parent);
+
+			// get_or_assign may have grown the pool, so look both components up again
+			auto& this_hierarchy = registry.get<Hierarchy>(entity);
+			auto& parent_hierarchy = registry.get<Hierarchy>(parent);
 
 			if (parent_hierarchy._first == entt::null) 
 			{
@@ -106,26 +352,16 @@ namespace Lumos
 			}
 			else
 			{
-				// get last children
-				auto prev_ent = parent_hierarchy._first;
-				auto current_hierarchy = registry.try_get<Hierarchy>(prev_ent);
-				while (current_hierarchy != nullptr && current_hierarchy->_next != entt::null)
-				{
-					prev_ent = current_hierarchy->_next;
-					current_hierarchy = registry.try_get<Hierarchy>(prev_ent);
-				}
-				// add new
-				current_hierarchy->_next = entity;
-				hierarchy._prev = prev_ent;
+				// add after the last child
+				registry.get<Hierarchy>(parent_hierarchy._last)._next = entity;
+				this_hierarchy._prev = parent_hierarchy._last;
 			}
-			//// sort
-		/*	registry.sort<Hierarchy>([&registry](const entt::entity lhs, const entt::entity rhs) {
-				auto& right_h = registry.get<Hierarchy>(rhs);
-				auto result = right_h.compare(registry, lhs);
-				return result;
-			});*/
+			parent_hierarchy._last = entity;
 		}
 
+		auto layout = registry.try_ctx<HierarchyLayout>();
+		if (layout)
+			layout->Insert(entity, registry);
 	}
 
 	void DeleteChildren(entt::entity parent, entt::registry& registry)
@@ -191,16 +427,21 @@ namespace Lumos
 			}
 		}
 
-		// sort
-	/*	registry.sort<Hierarchy>([&registry](const entt::entity lhs, const entt::entity rhs)
+		// if is the last child
+		if (hierarchy._next == entt::null && hierarchy._parent != entt::null)
 		{
-			auto& right_h = registry.get<Hierarchy>(rhs);
-			return right_h.compare(registry, lhs);
-		});*/
+			auto parent_hierarchy = registry.try_get<Hierarchy>(hierarchy._parent);
+			if (parent_hierarchy != nullptr)
+			{
+				parent_hierarchy->_last = hierarchy._prev;
+			}
+		}
 	}
 
 	void Hierarchy::on_destroy(entt::entity entity, entt::registry& registry) 
 	{
+		MarkTransformDirty(entity, registry);
+
 		auto& hierarchy = registry.get<Hierarchy>(entity);
 		// if is the first child
 		if (hierarchy._prev == entt::null || !registry.valid(hierarchy._prev))
@@ -240,11 +481,18 @@ namespace Lumos
 			}
 		}
 
-		// sort
-		//registry.sort<Hierarchy>([&registry](const entt::entity lhs, const entt::entity rhs) 
-		//{
-		//	auto& right_h = registry.get<Hierarchy>(rhs);
-		//	return right_h.compare(registry, lhs);
-		//});
+		// if is the last child
+		if (hierarchy._next == entt::null && hierarchy._parent != entt::null && registry.valid(hierarchy._parent))
+		{
+			auto parent_hierarchy = registry.try_get<Hierarchy>(hierarchy._parent);
+			if (parent_hierarchy != nullptr)
+			{
+				parent_hierarchy->_last = registry.valid(hierarchy._prev) ? hierarchy._prev : entt::null;
+			}
+		}
+
+		auto layout = registry.try_ctx<HierarchyLayout>();
+		if (layout)
+			layout->Remove(entity, registry);
 	}
 }
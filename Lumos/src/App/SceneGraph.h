@@ -1,6 +1,7 @@
 #pragma once
 
 #include <entt/entt.hpp>
+#include "Maths/Matrix4.h"
 
 namespace Lumos
 {
@@ -13,6 +14,7 @@ namespace Lumos
 		inline entt::entity next() const { return _next; }
 		inline entt::entity prev() const { return _prev; }
 		inline entt::entity first() const { return _first; }
+		inline entt::entity last() const { return _last; }
 
 		// Return true if rhs is an ancestor of rhs
 		bool compare(const entt::registry& registry, const entt::entity rhs) const;
@@ -31,6 +33,50 @@ namespace Lumos
 		entt::entity _first = entt::null;
 		entt::entity _next = entt::null;
 		entt::entity _prev = entt::null;
+		entt::entity _last = entt::null;
+
+		// Slot in the HierarchyLayout, maintained by the layout
+		u32 _index = ~0u;
+	};
+
+	// Hierarchy entities stored flat and sorted by depth, so parents always precede their children.
+	// Lives in the registry context and is kept up to date by the Hierarchy callbacks.
+	class HierarchyLayout
+	{
+	public:
+		static constexpr u32 Invalid = ~0u;
+
+		struct Node
+		{
+			entt::entity entity;
+			u32 parent;
+			// Parent that has a Transform but no Hierarchy node, such as one whose Hierarchy was removed
+			entt::entity external;
+			// Needs its world matrix recomputed this frame
+			bool dirty;
+			// World matrix changed during the last update
+			bool updated;
+		};
+
+		void Insert(entt::entity entity, entt::registry& registry);
+		void Remove(entt::entity entity, entt::registry& registry);
+
+		std::vector<Node>& GetNodes() { return m_Nodes; }
+		const std::vector<Node>& GetNodes() const { return m_Nodes; }
+		std::vector<Maths::Matrix4>& GetWorldMatrices() { return m_WorldMatrices; }
+
+		u32 GetLevelCount() const { return static_cast<u32>(m_LevelOffsets.size()) - 1; }
+		u32 GetLevelBegin(u32 level) const { return m_LevelOffsets[level]; }
+		u32 GetLevelEnd(u32 level) const { return m_LevelOffsets[level + 1]; }
+
+	private:
+		u32 GetLevel(u32 index) const;
+		void MoveNode(u32 from, u32 to, entt::registry& registry);
+
+		std::vector<Node> m_Nodes;
+		std::vector<Maths::Matrix4> m_WorldMatrices;
+		// First node of each depth level, with the node count as the last entry
+		std::vector<u32> m_LevelOffsets = { 0 };
 	};
 
     class SceneGraph
@@ -41,7 +87,8 @@ namespace Lumos
 
 		void Init(entt::registry & registry);
         
+		// Recomputes world matrices of changed transforms and their descendants, one depth level at a time.
+		// Each level is split across the JobSystem workers.
         void Update(entt::registry& registry);
-		void UpdateTransform(entt::entity entity, entt::registry& registry);
     };
 }
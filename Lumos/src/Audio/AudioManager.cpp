@@ -10,7 +10,7 @@ namespace Lumos
     AudioManager* AudioManager::Create()
     {
         #ifdef LUMOS_OPENAL
-        return lmnew Audio::ALManager();
+        return lmnew_tagged(Audio) Audio::ALManager();
         #else
         return nullptr;
         #endif
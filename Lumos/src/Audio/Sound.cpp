@@ -19,6 +19,8 @@ namespace Lumos
 
 	Sound* Sound::Create(const String& name, const String& extension)
 	{
+		LUMOS_MEMORY_TAG(Audio);
+
 #ifdef LUMOS_OPENAL
 		return lmnew ALSound(name, extension);
 #else
@@ -11,7 +11,7 @@ namespace Lumos
 	SoundNode* SoundNode::Create()
 	{
 #ifdef LUMOS_OPENAL
-		return lmnew ALSoundNode();
+		return lmnew_tagged(Audio) ALSoundNode();
 #else
 		return nullptr;
 #endif
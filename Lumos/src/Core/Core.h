@@ -140,7 +140,8 @@
     type_identifier(const type_identifier&) = delete;				\
     type_identifier& operator=(const type_identifier&) = delete;
 
-#ifndef LUMOS_PLATFORM_IOS
+// Build with LUMOS_NO_SSE (premake --no-sse) to compare against the scalar Maths paths
+#if !defined(LUMOS_PLATFORM_IOS) && !defined(LUMOS_NO_SSE)
 #define Lumos_SSE 
 #endif 
 
@@ -15,6 +15,8 @@ namespace Lumos
 	{
         Debug::Log::OnInit();
 
+		Profiler::SetThreadName("Main");
+
 		if (enableProfiler)
 		{
 			Profiler::Instance()->Enable();
@@ -32,6 +34,7 @@ namespace Lumos
 	void CoreSystem::Shutdown()
 	{
 		Debug::Log::Info("Shutting down System");
+		System::JobSystem::OnShutdown();
         Profiler::Release();
 		LuaManager::Release();
 		VFS::OnShutdown();
@@ -1,6 +1,7 @@
 #include "lmpch.h"
 #include "JobSystem.h"
 #include "Maths/Maths.h"
+#include "Profiler.h"
 
 #include <atomic>
 #include <thread>
@@ -10,126 +11,737 @@
 #ifdef LUMOS_PLATFORM_WINDOWS
 #define NOMINMAX
 #include <Windows.h>
+#elif defined(LUMOS_PLATFORM_LINUX)
+#include <pthread.h>
+#include <sched.h>
 #endif
-namespace Lumos 
+
+#define JOBSYSTEM_CACHE_LINE_SIZE 64
+
+namespace Lumos
 {
-    namespace System 
+    namespace System
     {
-        // Fixed size very simple thread safe ring buffer
-        template <typename T, size_t capacity>
-        class ThreadSafeRingBuffer
+        namespace JobSystem
+        {
+            namespace Internal
+            {
+                void CountAllocation();
+            }
+        }
+
+        // Chase-Lev work stealing deque ("Correct and Efficient Work-Stealing for Weak Memory Models", Le et al. 2013)
+        // The owning worker pushes and pops at the bottom, any other thread steals from the top.
+        // The ring grows when full, so there is no fixed job ceiling.
+        template <typename T>
+        class WorkStealingQueue
+        {
+        public:
+            explicit WorkStealingQueue(int64_t capacity = 1024)
+            {
+                m_Top.store(0, std::memory_order_relaxed);
+                m_Bottom.store(0, std::memory_order_relaxed);
+                m_Array.store(lmnew Array(capacity), std::memory_order_relaxed);
+            }
+
+            ~WorkStealingQueue()
+            {
+                for (auto array : m_Retired)
+                    lmdel array;
+                lmdel m_Array.load(std::memory_order_relaxed);
+            }
+
+            // Owner thread only
+            void Push(T item)
+            {
+                int64_t b = m_Bottom.load(std::memory_order_relaxed);
+                int64_t t = m_Top.load(std::memory_order_acquire);
+                Array* a = m_Array.load(std::memory_order_relaxed);
+
+                if (b - t > a->Capacity() - 1)
+                    a = Grow(a, t, b);
+
+                a->Put(b, item);
+                std::atomic_thread_fence(std::memory_order_release);
+                m_Bottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+            // Owner thread only
+            bool Pop(T& item)
+            {
+                int64_t b = m_Bottom.load(std::memory_order_relaxed) - 1;
+                Array* a = m_Array.load(std::memory_order_relaxed);
+                m_Bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t t = m_Top.load(std::memory_order_relaxed);
+
+                if (t > b)
+                {
+                    // Empty
+                    m_Bottom.store(b + 1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                item = a->Get(b);
+
+                if (t == b)
+                {
+                    // Last item, race against stealers
+                    bool won = m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                    m_Bottom.store(b + 1, std::memory_order_relaxed);
+                    return won;
+                }
+
+                return true;
+            }
+
+            // Any thread
+            bool Steal(T& item)
+            {
+                int64_t t = m_Top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t b = m_Bottom.load(std::memory_order_acquire);
+
+                if (t >= b)
+                    return false;
+
+                Array* a = m_Array.load(std::memory_order_acquire);
+                T x = a->Get(t);
+
+                if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    return false;
+
+                item = x;
+                return true;
+            }
+
+            // Approximate, only used to decide whether a worker may go to sleep
+            bool Empty() const
+            {
+                int64_t b = m_Bottom.load(std::memory_order_relaxed);
+                int64_t t = m_Top.load(std::memory_order_relaxed);
+                return b <= t;
+            }
+
+        private:
+            class Array
+            {
+            public:
+                explicit Array(int64_t capacity) : m_Capacity(capacity), m_Mask(capacity - 1)
+                {
+                    LUMOS_ASSERT((capacity & (capacity - 1)) == 0, "WorkStealingQueue capacity must be a power of two");
+                    m_Data = lmnew std::atomic<T>[static_cast<size_t>(capacity)];
+                }
+
+                ~Array() { lmdel[] m_Data; }
+
+                int64_t Capacity() const { return m_Capacity; }
+                void Put(int64_t i, T item) { m_Data[i & m_Mask].store(item, std::memory_order_relaxed); }
+                T Get(int64_t i) const { return m_Data[i & m_Mask].load(std::memory_order_relaxed); }
+
+            private:
+                int64_t m_Capacity;
+                int64_t m_Mask;
+                std::atomic<T>* m_Data;
+            };
+
+            Array* Grow(Array* a, int64_t t, int64_t b)
+            {
+                JobSystem::Internal::CountAllocation();
+                Array* grown = lmnew Array(a->Capacity() * 2);
+                for (int64_t i = t; i < b; ++i)
+                    grown->Put(i, a->Get(i));
+
+                // Stealers may still be reading from the old array, keep it alive until the queue is destroyed
+                m_Retired.push_back(a);
+                m_Array.store(grown, std::memory_order_release);
+                return grown;
+            }
+
+            alignas(JOBSYSTEM_CACHE_LINE_SIZE) std::atomic<int64_t> m_Top;
+            alignas(JOBSYSTEM_CACHE_LINE_SIZE) std::atomic<int64_t> m_Bottom;
+            alignas(JOBSYSTEM_CACHE_LINE_SIZE) std::atomic<Array*> m_Array;
+            std::vector<Array*> m_Retired;
+        };
+
+        // Intrusive multi producer queue (Vyukov) used for jobs submitted from outside the worker threads.
+        // Push is a single atomic exchange. Consumers take a try-lock so a worker never blocks on it,
+        // a worker that loses the race simply goes on to steal from another queue.
+        class InjectionQueue
         {
         public:
-            // Push an item to the end if there is free space
-            //	Returns true if succesful
-            //	Returns false if there is not enough space
-            _FORCE_INLINE_ bool push_back(const T& item)
+            InjectionQueue()
+            {
+                m_Stub.next.store(nullptr, std::memory_order_relaxed);
+                m_Head.store(&m_Stub, std::memory_order_relaxed);
+                m_Tail = &m_Stub;
+                m_ConsumerLock.clear();
+            }
+
+            void Push(Job* job)
+            {
+                job->next.store(nullptr, std::memory_order_relaxed);
+                Job* prev = m_Head.exchange(job, std::memory_order_acq_rel);
+                prev->next.store(job, std::memory_order_release);
+            }
+
+            bool TryPop(Job*& job)
+            {
+                if (m_ConsumerLock.test_and_set(std::memory_order_acquire))
+                    return false;
+
+                job = PopInternal();
+                m_ConsumerLock.clear(std::memory_order_release);
+                return job != nullptr;
+            }
+
+            // Approximate, only used to decide whether a worker may go to sleep
+            bool Empty() const
+            {
+                return m_Head.load(std::memory_order_relaxed) == &m_Stub;
+            }
+
+        private:
+            Job* PopInternal()
             {
-                bool result = false;
-                lock.lock();
-                size_t next = (head + 1) % capacity;
-                if (next != tail)
+                Job* tail = m_Tail;
+                Job* next = tail->next.load(std::memory_order_acquire);
+
+                if (tail == &m_Stub)
+                {
+                    if (next == nullptr)
+                        return nullptr;
+
+                    m_Tail = next;
+                    tail = next;
+                    next = next->next.load(std::memory_order_acquire);
+                }
+
+                if (next)
+                {
+                    m_Tail = next;
+                    return tail;
+                }
+
+                // A producer is between the exchange and the link, try again later
+                if (tail != m_Head.load(std::memory_order_acquire))
+                    return nullptr;
+
+                Push(&m_Stub);
+
+                next = tail->next.load(std::memory_order_acquire);
+                if (next)
                 {
-                    data[head] = item;
-                    head = next;
-                    result = true;
+                    m_Tail = next;
+                    return tail;
                 }
-                lock.unlock();
-                return result;
+
+                return nullptr;
+            }
+
+            alignas(JOBSYSTEM_CACHE_LINE_SIZE) std::atomic<Job*> m_Head;
+            alignas(JOBSYSTEM_CACHE_LINE_SIZE) Job* m_Tail;
+            std::atomic_flag m_ConsumerLock;
+            Job m_Stub;
+        };
+
+        // Recycles jobs through per thread caches backed by a shared free list.
+        // Jobs freed by a worker go to that worker's cache and flow back to the submitting threads in batches.
+        class JobPool
+        {
+        public:
+            // Jobs per heap block
+            static const uint32_t BlockSize = 256;
+
+            // Jobs moved between a thread cache and the shared free list in one go
+            static const uint32_t BatchSize = 64;
+
+            struct Cache
+            {
+                Job* head = nullptr;
+                uint32_t count = 0;
+
+                ~Cache();
+            };
+
+            ~JobPool()
+            {
+                for (auto block : m_Blocks)
+                    lmdel[] block;
+            }
+
+            Job* Allocate(Cache& cache)
+            {
+                if (cache.head == nullptr)
+                    Refill(cache);
+
+                Job* job = cache.head;
+                cache.head = job->next.load(std::memory_order_relaxed);
+                --cache.count;
+                return job;
             }
 
-            // Get an item if there are any
-            //	Returns true if succesful
-            //	Returns false if there are no items
-            _FORCE_INLINE_ bool pop_front(T& item)
+            void Free(Cache& cache, Job* job)
             {
-                bool result = false;
-                lock.lock();
-                if (tail != head)
+                job->next.store(cache.head, std::memory_order_relaxed);
+                cache.head = job;
+
+                if (++cache.count >= BatchSize * 2)
+                    Return(cache, BatchSize);
+            }
+
+            void Return(Cache& cache, uint32_t count)
+            {
+                std::lock_guard<std::mutex> lock(m_Lock);
+                while (cache.head && count-- > 0)
                 {
-                    item = data[tail];
-                    tail = (tail + 1) % capacity;
-                    result = true;
+                    Job* job = cache.head;
+                    cache.head = job->next.load(std::memory_order_relaxed);
+                    --cache.count;
+
+                    job->next.store(m_Free, std::memory_order_relaxed);
+                    m_Free = job;
                 }
-                lock.unlock();
-                return result;
             }
 
         private:
-            T data[capacity];
-            size_t head = 0;
-            size_t tail = 0;
-            std::mutex lock; // this just works better than a spinlock here (on windows)
+            void Refill(Cache& cache)
+            {
+                std::lock_guard<std::mutex> lock(m_Lock);
+
+                if (m_Free == nullptr)
+                {
+                    JobSystem::Internal::CountAllocation();
+                    Job* block = lmnew Job[BlockSize];
+                    m_Blocks.push_back(block);
+
+                    for (uint32_t i = 0; i < BlockSize; ++i)
+                    {
+                        block[i].next.store(m_Free, std::memory_order_relaxed);
+                        m_Free = &block[i];
+                    }
+                }
+
+                for (uint32_t i = 0; i < BatchSize && m_Free; ++i)
+                {
+                    Job* job = m_Free;
+                    m_Free = job->next.load(std::memory_order_relaxed);
+
+                    job->next.store(cache.head, std::memory_order_relaxed);
+                    cache.head = job;
+                    ++cache.count;
+                }
+            }
+
+            std::mutex m_Lock;
+            Job* m_Free = nullptr;
+            std::vector<Job*> m_Blocks;
         };
 
         namespace JobSystem
         {
+            static const uint32_t InvalidWorkerIndex = ~0u;
+
+            // Number of jobs moved from the injection queue to a worker's own deque in one go,
+            // so other workers can steal them without contending on the injection queue
+            static const uint32_t InjectionBatchSize = 32;
+
+            // Attempts to find a job before a worker goes to sleep
+            static const uint32_t SpinCount = 64;
+
             uint32_t numThreads = 0;
-            ThreadSafeRingBuffer<std::function<void()>, 256> jobPool;
+            Settings currentSettings;
+            std::vector<Scope<WorkStealingQueue<Job*>>> workerQueues;
+            std::vector<std::thread> workerThreads;
+            InjectionQueue injectionQueue;
+            JobPool jobPool;
+
             std::condition_variable wakeCondition;
             std::mutex wakeMutex;
-            uint64_t currentLabel = 0;
+            std::atomic<uint32_t> sleepingThreads;
+
+            // Threads blocked in Wait/WaitFor with nothing to help with
+            std::condition_variable idleCondition;
+            std::mutex idleMutex;
+            std::atomic<uint32_t> waitingThreads;
+            std::atomic<bool> running;
+
+            std::atomic<uint64_t> currentLabel;
             std::atomic<uint64_t> finishedLabel;
 
-            void OnInit()
+            std::atomic<uint32_t> frameAllocations;
+            uint32_t lastFrameAllocations = 0;
+
+            thread_local uint32_t t_WorkerIndex = InvalidWorkerIndex;
+            thread_local uint32_t t_RandomState = 0;
+            thread_local JobPool::Cache t_JobCache;
+
+            _FORCE_INLINE_ uint32_t NextRandom()
             {
-                finishedLabel.store(0);
+                // xorshift32
+                uint32_t x = t_RandomState;
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                t_RandomState = x;
+                return x;
+            }
 
-                // Retrieve the number of hardware threads in this System:
-                auto numCores = std::thread::hardware_concurrency();
+            bool HasPendingJobs()
+            {
+                if (!injectionQueue.Empty())
+                    return true;
+
+                for (auto& queue : workerQueues)
+                {
+                    if (!queue->Empty())
+                        return true;
+                }
 
-                // Calculate the actual number of worker threads we want:
-                numThreads = Lumos::Maths::Max(1U, numCores);
+                return false;
+            }
 
-                for (uint32_t threadID = 0; threadID < numThreads; ++threadID)
+            bool FindJob(Job*& job)
+            {
+                const uint32_t workerIndex = t_WorkerIndex;
+
+                if (workerIndex != InvalidWorkerIndex && workerQueues[workerIndex]->Pop(job))
+                    return true;
+
+                if (injectionQueue.TryPop(job))
+                {
+                    if (workerIndex != InvalidWorkerIndex)
+                    {
+                        Job* extra = nullptr;
+                        uint32_t moved = 0;
+                        while (moved < InjectionBatchSize && injectionQueue.TryPop(extra))
+                        {
+                            workerQueues[workerIndex]->Push(extra);
+                            ++moved;
+                        }
+
+                        if (moved > 0)
+                            Internal::WakeWorkers(moved > 1);
+                    }
+                    return true;
+                }
+
+                if (numThreads == 0)
+                    return false;
+
+                // Steal starting from a random victim
+                const uint32_t start = NextRandom() % numThreads;
+                for (uint32_t i = 0; i < numThreads; ++i)
+                {
+                    const uint32_t victim = (start + i) % numThreads;
+                    if (victim != workerIndex && workerQueues[victim]->Steal(job))
+                        return true;
+                }
+
+                return false;
+            }
+
+            // Wakes threads blocked in Wait/WaitFor after a batch or all submitted work completed
+            void NotifyWaiters()
+            {
+                // Pairs with the fence in HelpUntil, same as WakeWorkers
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (waitingThreads.load(std::memory_order_relaxed) == 0)
+                    return;
+
+                {
+                    std::lock_guard<std::mutex> lock(idleMutex);
+                }
+                idleCondition.notify_all();
+            }
+
+            namespace Internal
+            {
+                void CountAllocation()
+                {
+                    frameAllocations.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                Job* AllocateJob()
+                {
+                    return jobPool.Allocate(t_JobCache);
+                }
+
+                void Track(Context* ctx, uint32_t jobCount)
+                {
+                    // The label states are updated before any job becomes visible:
+                    currentLabel.fetch_add(jobCount);
+                    if (ctx)
+                        ctx->counter.fetch_add(jobCount);
+                }
+
+                void Enqueue(Job* job)
                 {
-                    std::thread worker([] {
+                    const uint32_t workerIndex = t_WorkerIndex;
+                    if (workerIndex != InvalidWorkerIndex)
+                        workerQueues[workerIndex]->Push(job);
+                    else
+                        injectionQueue.Push(job);
+                }
+
+                void WakeWorkers(bool all)
+                {
+                    // Pairs with the fence in WorkerLoop so either the worker sees the new job or we see the sleeping worker
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (sleepingThreads.load(std::memory_order_relaxed) > 0)
+                    {
+                        {
+                            // Workers increment sleepingThreads under this lock, taking it guarantees they are now waiting
+                            std::lock_guard<std::mutex> lock(wakeMutex);
+                        }
+
+                        if (all)
+                            wakeCondition.notify_all();
+                        else
+                            wakeCondition.notify_one();
+                    }
+
+                    // Waiting threads help out as well
+                    if (waitingThreads.load(std::memory_order_relaxed) > 0)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(idleMutex);
+                        }
+                        idleCondition.notify_all();
+                    }
+                }
+
+                void AddContinuation(Context& dependency, Job* job)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(dependency.lock);
+                        if (dependency.counter.load(std::memory_order_acquire) > 0)
+                        {
+                            job->next.store(dependency.continuations, std::memory_order_relaxed);
+                            dependency.continuations = job;
+                            return;
+                        }
+                    }
 
-                        std::function<void()> job;
+                    // Dependency already finished
+                    Enqueue(job);
+                    WakeWorkers(false);
+                }
+            }
 
-                        while (true)
+            void Finish(Context* ctx)
+            {
+                uint32_t count = ctx->counter.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    if (count > 1)
+                    {
+                        if (ctx->counter.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                            return;
+                        continue;
+                    }
+
+                    // Last job of the batch. The counter is released under the lock so WaitFor can't return,
+                    // and the owner can't destroy ctx, before the continuations have been detached
+                    Job* continuations = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lock(ctx->lock);
+                        if (!ctx->counter.compare_exchange_strong(count, 0, std::memory_order_acq_rel, std::memory_order_relaxed))
+                            continue; // More jobs were added in the meantime
+
+                        continuations = ctx->continuations;
+                        ctx->continuations = nullptr;
+                    }
+
+                    // ctx may be gone from here on
+                    NotifyWaiters();
+
+                    if (continuations)
+                    {
+                        while (continuations)
                         {
-                            if (jobPool.pop_front(job))
-                            {
-                                job(); // execute job
-                                finishedLabel.fetch_add(1); // update worker label state
-                            }
-                            else
-                            {
-                                // no job, put thread to sleep
-                                std::unique_lock<std::mutex> lock(wakeMutex);
-                                wakeCondition.wait(lock);
-                            }
+                            Job* next = continuations->next.load(std::memory_order_relaxed);
+                            Internal::Enqueue(continuations);
+                            continuations = next;
                         }
+                        Internal::WakeWorkers(true);
+                    }
+                    return;
+                }
+            }
+
+            _FORCE_INLINE_ void RunJob(Job* job)
+            {
+                {
+#ifdef LUMOS_MEMORY_TRACKING
+                    MemoryTagScope tagScope(job->tag);
+#endif
+                    job->task(); // execute job
+                    job->task.Reset();
+                }
+
+                if (job->context)
+                    Finish(job->context);
+
+                jobPool.Free(t_JobCache, job);
+                // update worker label state
+                if (finishedLabel.fetch_add(1, std::memory_order_acq_rel) + 1 == currentLabel.load(std::memory_order_acquire))
+                    NotifyWaiters();
+            }
+
+            void WorkerLoop(uint32_t threadIndex)
+            {
+                t_WorkerIndex = threadIndex;
+                t_RandomState = threadIndex * 2654435761u + 1u;
+                Profiler::SetThreadName("JobSystem_" + std::to_string(threadIndex));
 
-                    });
+                Job* job = nullptr;
+                uint32_t spin = 0;
+
+                while (running.load(std::memory_order_relaxed))
+                {
+                    if (FindJob(job))
+                    {
+                        RunJob(job);
+                        spin = 0;
+                        continue;
+                    }
+
+                    if (++spin < SpinCount)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    // no job, put thread to sleep
+                    std::unique_lock<std::mutex> lock(wakeMutex);
+                    sleepingThreads.fetch_add(1, std::memory_order_seq_cst);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    wakeCondition.wait(lock, [] { return !running.load(std::memory_order_relaxed) || HasPendingJobs(); });
+                    sleepingThreads.fetch_sub(1, std::memory_order_relaxed);
+                    spin = 0;
+                }
+            }
+
+            void OnInit(const Settings& settings)
+            {
+                currentLabel.store(0);
+                finishedLabel.store(0);
+                sleepingThreads.store(0);
+                waitingThreads.store(0);
+                running.store(true);
+
+                currentSettings = settings;
+
+                // Retrieve the number of hardware threads in this System:
+                auto numCores = Lumos::Maths::Max(1U, std::thread::hardware_concurrency());
+
+                // Calculate the actual number of worker threads we want, by default one less than the cores as the main thread runs jobs too:
+                numThreads = settings.WorkerCount > 0 ? settings.WorkerCount : Lumos::Maths::Max(1U, numCores - 1);
+
+                workerQueues.clear();
+                for (uint32_t threadID = 0; threadID < numThreads; ++threadID)
+                    workerQueues.emplace_back(CreateScope<WorkStealingQueue<Job*>>());
+
+                for (uint32_t threadID = 0; threadID < numThreads; ++threadID)
+                {
+                    std::thread worker(WorkerLoop, threadID);
+
+                    // Core 0 is left to the main thread
+                    const uint32_t core = (threadID + 1) % numCores;
 
         #ifdef LUMOS_PLATFORM_WINDOWS
                     // Do Windows-specific thread setup:
                     HANDLE handle = (HANDLE)worker.native_handle();
 
-                    // Put each thread on to dedicated core
-                    DWORD_PTR affinityMask = 1ull << threadID; 
-                    DWORD_PTR affinity_result = SetThreadAffinityMask(handle, affinityMask);
-                    LUMOS_ASSERT(affinity_result > 0,"");
+                    if (settings.PinThreads)
+                    {
+                        // Put each thread on to dedicated core
+                        DWORD_PTR affinityMask = 1ull << core;
+                        DWORD_PTR affinity_result = SetThreadAffinityMask(handle, affinityMask);
+                        LUMOS_ASSERT(affinity_result > 0,"");
+                    }
+
                     // Name the thread:
                     std::wstringstream wss;
                     wss << "JobSystem_" << threadID;
                     HRESULT hr = SetThreadDescription(handle, wss.str().c_str());
                     LUMOS_ASSERT(SUCCEEDED(hr),"");
-        #endif // LUMOS_PLATFORM_WINDOWS
-
-                    worker.detach();
+        #elif defined(LUMOS_PLATFORM_LINUX)
+                    pthread_t handle = worker.native_handle();
+
+                    if (settings.PinThreads)
+                    {
+                        cpu_set_t cpuSet;
+                        CPU_ZERO(&cpuSet);
+                        CPU_SET(core, &cpuSet);
+                        if (pthread_setaffinity_np(handle, sizeof(cpu_set_t), &cpuSet) != 0)
+                            LUMOS_LOG_WARN("Failed to pin JobSystem thread {0} to core {1}", threadID, core);
+                    }
+
+                    // Thread names are limited to 15 characters
+                    char name[16];
+                    snprintf(name, sizeof(name), "JobSystem_%u", threadID);
+                    pthread_setname_np(handle, name);
+        #endif
+
+                    workerThreads.push_back(std::move(worker));
                 }
 
                 LUMOS_LOG_INFO("Initialised JobSystem with [{0} cores] [{1} threads]" ,numCores, numThreads);
             }
 
-            // This little function will not let the System to be deadlocked while the main thread is waiting for something
-            _FORCE_INLINE_ void poll()
+            void Configure(const Settings& settings)
+            {
+                if (settings.WorkerCount == currentSettings.WorkerCount && settings.PinThreads == currentSettings.PinThreads)
+                    return;
+
+                // Restart the workers, anything submitted so far completes first
+                Wait();
+                OnShutdown();
+                OnInit(settings);
+            }
+
+            void OnShutdown()
+            {
+                running.store(false);
+
+                {
+                    std::lock_guard<std::mutex> lock(wakeMutex);
+                }
+                wakeCondition.notify_all();
+
+                for (auto& worker : workerThreads)
+                {
+                    if (worker.joinable())
+                        worker.join();
+                }
+
+                // Discard anything left so the jobs go back to the pool
+                Job* job = nullptr;
+                while (injectionQueue.TryPop(job))
+                {
+                    job->task.Reset();
+                    jobPool.Free(t_JobCache, job);
+                }
+                for (auto& queue : workerQueues)
+                {
+                    while (queue->Steal(job))
+                    {
+                        job->task.Reset();
+                        jobPool.Free(t_JobCache, job);
+                    }
+                }
+
+                workerThreads.clear();
+                workerQueues.clear();
+                numThreads = 0;
+            }
+
+            void OnFrameEnd()
             {
-                wakeCondition.notify_one(); // wake one worker thread
-                std::this_thread::yield(); // allow this thread to be rescheduled
+                lastFrameAllocations = frameAllocations.exchange(0, std::memory_order_relaxed);
             }
 
             uint32_t GetThreadCount()
@@ -137,69 +749,88 @@ namespace Lumos
                 return numThreads;
             }
 
-            void Execute(const std::function<void()>& job)
+            uint32_t GetAllocationCount()
             {
-                // The main thread label state is updated:
-                currentLabel += 1;
-
-                // Try to push a new job until it is pushed successfully:
-                while (!jobPool.push_back(job)) { poll(); }
+                return frameAllocations.load(std::memory_order_relaxed);
+            }
 
-                wakeCondition.notify_one(); // wake one thread
+            uint32_t GetLastFrameAllocationCount()
+            {
+                return lastFrameAllocations;
             }
 
-            void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job)
+            bool IsBusy()
             {
-                if (jobCount == 0 || groupSize == 0)
-                {
-                    return;
-                }
+                // Whenever the submitted label is not reached by the workers, it indicates that some worker is still alive
+                return finishedLabel.load(std::memory_order_acquire) < currentLabel.load(std::memory_order_acquire);
+            }
 
-                // Calculate the amount of job groups to dispatch (overestimate, or "ceil"):
-                const uint32_t groupCount = (jobCount + groupSize - 1) / groupSize;
+            bool IsBusy(const Context& ctx)
+            {
+                return ctx.counter.load(std::memory_order_acquire) > 0;
+            }
 
-                // The main thread label state is updated:
-                currentLabel += groupCount;
+            // Runs pending jobs on the calling thread until done() holds, sleeping when there is nothing to run
+            template <typename Done>
+            void HelpUntil(const Done& done)
+            {
+                Job* job = nullptr;
+                uint32_t spin = 0;
 
-                for (uint32_t groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+                while (!done())
                 {
-                    // For each group, generate one real job:
-                    const auto& jobGroup = [jobCount, groupSize, job, groupIndex]() {
-
-                        // Calculate the current group's offset into the jobs:
-                        const uint32_t groupJobOffset = groupIndex * groupSize;
-                        const uint32_t groupJobEnd = Lumos::Maths::Min(groupJobOffset + groupSize, jobCount);
-
-                        JobDispatchArgs args;
-                        args.groupIndex = groupIndex;
-
-                        // Inside the group, loop through all job indices and execute job for each index:
-                        for (uint32_t i = groupJobOffset; i < groupJobEnd; ++i)
+                    if (FindJob(job))
+                    {
+                        // Workers only get here from inside a job, time spent helping is only interesting on other threads
+                        if (t_WorkerIndex == InvalidWorkerIndex)
                         {
-                            args.jobIndex = i;
-                            job(args);
+                            LUMOS_PROFILE_BLOCK("JobSystem::Wait Helping");
+                            RunJob(job);
                         }
-                    };
-
-                    // Try to push a new job until it is pushed successfully:
-                    while (!jobPool.push_back(jobGroup)) { poll(); }
-
-                    wakeCondition.notify_one(); // wake one thread
+                        else
+                            RunJob(job);
+                        spin = 0;
+                        continue;
+                    }
+
+                    if (++spin < SpinCount)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    // Nothing runnable, the remaining jobs are in flight on the workers
+                    std::unique_lock<std::mutex> lock(idleMutex);
+                    waitingThreads.fetch_add(1, std::memory_order_seq_cst);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    {
+                        LUMOS_PROFILE_BLOCK("JobSystem::Wait Idle");
+                        idleCondition.wait(lock, [&] { return done() || HasPendingJobs(); });
+                    }
+                    waitingThreads.fetch_sub(1, std::memory_order_relaxed);
+                    spin = 0;
                 }
-
-
             }
 
-            bool IsBusy()
+            void Wait()
             {
-                // Whenever the main thread label is not reached by the workers, it indicates that some worker is still alive
-                return finishedLabel.load() < currentLabel;
+                HelpUntil([] { return !IsBusy(); });
             }
 
-            void Wait()
+            void WaitFor(Context& ctx)
             {
-                while (IsBusy()) { poll(); }
+                HelpUntil([&ctx] { return !IsBusy(ctx); });
+
+                // The last job releases the counter while holding the lock, make sure it has let go of ctx
+                std::lock_guard<std::mutex> lock(ctx.lock);
             }
         }
+
+        JobPool::Cache::~Cache()
+        {
+            // Thread exit, hand everything back to the shared list
+            if (head)
+                JobSystem::jobPool.Return(*this, count);
+        }
     }
 }
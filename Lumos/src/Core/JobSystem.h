@@ -1,36 +1,365 @@
 #pragma once
 #include "lmpch.h"
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+// Bytes of captured state a job can hold without allocating
+#define JOB_INLINE_STORAGE_SIZE 128
+
+// ParallelFor sizes its chunks to take roughly this long, from the measured cost per item
+#define JOB_PARALLEL_FOR_CHUNK_NS 20000.0f
+
+// ParallelFor ranges estimated to take less than this run on the calling thread
+#define JOB_PARALLEL_FOR_INLINE_NS 40000.0f
+
+// Items timed on the calling thread the first time a ParallelFor call site runs
+#define JOB_PARALLEL_FOR_PROBE_SIZE 8u
+
 struct JobDispatchArgs
 {
 	uint32_t jobIndex;
 	uint32_t groupIndex;
 };
 
-namespace Lumos 
+namespace Lumos
 {
-    namespace System 
+    namespace System
     {
         namespace JobSystem
         {
-            void OnInit();
+            struct Context;
+        }
+
+        // Type erased callable stored inside the job itself, so submitting never allocates
+        class JobFunction
+        {
+        public:
+            JobFunction() = default;
+            ~JobFunction() { Reset(); }
+
+            NONCOPYABLE(JobFunction)
+
+            template <typename F>
+            void Set(F&& func)
+            {
+                using Functor = typename std::decay<F>::type;
+                static_assert(sizeof(Functor) <= JOB_INLINE_STORAGE_SIZE, "Job captures too much state, capture by reference or through a pointer");
+                static_assert(alignof(Functor) <= MEM_ALIGNMENT, "Job captures over-aligned state");
+
+                Reset();
+                new (m_Storage) Functor(std::forward<F>(func));
+                m_Invoke = [](void* storage) { (*static_cast<Functor*>(storage))(); };
+                m_Destroy = [](void* storage) { static_cast<Functor*>(storage)->~Functor(); };
+            }
+
+            void operator()() { m_Invoke(m_Storage); }
+
+            void Reset()
+            {
+                if (m_Destroy)
+                {
+                    m_Destroy(m_Storage);
+                    m_Destroy = nullptr;
+                    m_Invoke = nullptr;
+                }
+            }
+
+        private:
+            alignas(MEM_ALIGNMENT) u8 m_Storage[JOB_INLINE_STORAGE_SIZE];
+            void (*m_Invoke)(void*) = nullptr;
+            void (*m_Destroy)(void*) = nullptr;
+        };
+
+        struct Job
+        {
+            JobFunction task;
+            JobSystem::Context* context = nullptr;
+            // Memory tag of the submitting thread, applied while the job runs
+            MemoryTag tag = MemoryTag::General;
+            std::atomic<Job*> next { nullptr };
+        };
+
+        namespace JobSystem
+        {
+            // Tracks one batch of jobs so it can be waited on without waiting on unrelated work.
+            // Continuations registered with ExecuteAfter/DispatchAfter are launched once every job of the batch has finished.
+            // A context must outlive its jobs, call WaitFor before it goes out of scope.
+            struct Context
+            {
+                std::atomic<uint32_t> counter { 0 };
+                std::mutex lock;
+                Job* continuations = nullptr;
+            };
+
+            namespace Internal
+            {
+                // Jobs come from a pool with per thread caches, only growing the pool touches the heap
+                Job* AllocateJob();
+                void Track(Context* ctx, uint32_t jobCount);
+                void Enqueue(Job* job);
+                void WakeWorkers(bool all);
+                void AddContinuation(Context& dependency, Job* job);
+
+                template <typename F>
+                Job* CreateJob(Context* ctx, F&& task)
+                {
+                    Job* job = AllocateJob();
+                    job->task.Set(std::forward<F>(task));
+                    job->context = ctx;
+                    job->tag = Memory::GetCurrentTag();
+                    return job;
+                }
+
+                template <typename F>
+                void Dispatch(Context* ctx, uint32_t jobCount, uint32_t groupSize, const F& job)
+                {
+                    if (jobCount == 0 || groupSize == 0)
+                    {
+                        return;
+                    }
+
+                    // Calculate the amount of job groups to dispatch (overestimate, or "ceil"):
+                    const uint32_t groupCount = (jobCount + groupSize - 1) / groupSize;
+
+                    Track(ctx, groupCount);
+
+                    for (uint32_t groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+                    {
+                        // For each group, generate one real job:
+                        Enqueue(CreateJob(ctx, [job, jobCount, groupSize, groupIndex]()
+                        {
+                            // Calculate the current group's offset into the jobs:
+                            const uint32_t groupJobOffset = groupIndex * groupSize;
+                            const uint32_t groupJobEnd = std::min(groupJobOffset + groupSize, jobCount);
+
+                            JobDispatchArgs args;
+                            args.groupIndex = groupIndex;
+
+                            // Inside the group, loop through all job indices and execute job for each index:
+                            for (uint32_t i = groupJobOffset; i < groupJobEnd; ++i)
+                            {
+                                args.jobIndex = i;
+                                job(args);
+                            }
+                        }));
+                    }
+
+                    WakeWorkers(groupCount > 1);
+                }
+
+                // Average cost of one item of a ParallelFor call site in nanoseconds, zero until measured
+                using ItemCost = std::atomic<float>;
+
+                template <typename F>
+                void RunChunk(const F& func, uint32_t begin, uint32_t end, ItemCost* cost)
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    func(begin, end);
+                    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+                    // Racy read-modify-write on purpose, this is only an estimate
+                    const float measured = std::max(static_cast<float>(elapsed) / static_cast<float>(end - begin), 0.01f);
+                    const float previous = cost->load(std::memory_order_relaxed);
+                    cost->store(previous == 0.0f ? measured : previous + (measured - previous) * 0.25f, std::memory_order_relaxed);
+                }
+
+                template <typename F>
+                void SplitRange(Context* ctx, const F& func, uint32_t begin, uint32_t end, uint32_t grain, ItemCost* cost)
+                {
+                    // Hand the upper half off until a single grain is left for this thread.
+                    // Thieves take the oldest, biggest halves and keep splitting them the same way.
+                    while (end - begin > grain)
+                    {
+                        const uint32_t middle = begin + (end - begin) / 2;
+
+                        Track(ctx, 1);
+                        Enqueue(CreateJob(ctx, [ctx, func, middle, end, grain, cost]()
+                        {
+                            SplitRange(ctx, func, middle, end, grain, cost);
+                        }));
+                        WakeWorkers(false);
+
+                        end = middle;
+                    }
+
+                    RunChunk(func, begin, end, cost);
+                }
+            }
+
+            struct Settings
+            {
+                // Worker threads to start, 0 leaves one hardware thread for the main thread and uses the rest
+                uint32_t WorkerCount = 0;
+
+                // Pin every worker to its own core, leaving core 0 to the main thread
+                bool PinThreads = false;
+            };
+
+            void OnInit(const Settings& settings = Settings());
+
+            // Restarts the workers if the settings changed. Waits for all submitted jobs first.
+            void Configure(const Settings& settings);
+
+            // Stops and joins every worker thread. Jobs still queued are discarded.
+            void OnShutdown();
+
+            // Rolls the per frame statistics over, called once at the end of every frame
+            void OnFrameEnd();
 
             uint32_t GetThreadCount();
 
+            // Heap allocations made by the job system (job pool and queue growth) in the current / last frame.
+            // Zero once the pool has warmed up.
+            uint32_t GetAllocationCount();
+            uint32_t GetLastFrameAllocationCount();
+
             // Add a job to execute asynchronously. Any idle thread will execute this job.
-            void Execute(const std::function<void()>& job);
+            // Jobs submitted from a worker go to that worker's own queue, jobs from any other thread go to the shared injection queue.
+            // The callable is copied into the job, it must fit in JOB_INLINE_STORAGE_SIZE bytes.
+            template <typename F>
+            void Execute(F&& job)
+            {
+                Internal::Track(nullptr, 1);
+                Internal::Enqueue(Internal::CreateJob(nullptr, std::forward<F>(job)));
+                Internal::WakeWorkers(false);
+            }
 
             // Divide a job onto multiple jobs and execute in parallel.
             //	jobCount	: how many jobs to generate for this task.
             //	groupSize	: how many jobs to execute per thread. Jobs inside a group execute serially. It might be worth to increase for small jobs
             //	func		: receives a JobDispatchArgs as parameter
-            void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job);
+            template <typename F>
+            void Dispatch(uint32_t jobCount, uint32_t groupSize, const F& job)
+            {
+                Internal::Dispatch(nullptr, jobCount, groupSize, job);
+            }
+
+            // Same as above, but the jobs are tracked by ctx
+            template <typename F>
+            void Execute(Context& ctx, F&& job)
+            {
+                Internal::Track(&ctx, 1);
+                Internal::Enqueue(Internal::CreateJob(&ctx, std::forward<F>(job)));
+                Internal::WakeWorkers(false);
+            }
+
+            template <typename F>
+            void Dispatch(Context& ctx, uint32_t jobCount, uint32_t groupSize, const F& job)
+            {
+                Internal::Dispatch(&ctx, jobCount, groupSize, job);
+            }
+
+            // Run the job(s) once every job of dependency has finished. They are tracked by ctx from the moment of the call,
+            // so WaitFor(ctx) also covers work that has not been launched yet. Chaining these builds a job graph.
+            template <typename F>
+            void ExecuteAfter(Context& dependency, Context& ctx, F&& job)
+            {
+                Internal::Track(&ctx, 1);
+                Internal::AddContinuation(dependency, Internal::CreateJob(&ctx, std::forward<F>(job)));
+            }
+
+            template <typename F>
+            void DispatchAfter(Context& dependency, Context& ctx, uint32_t jobCount, uint32_t groupSize, const F& job)
+            {
+                if (jobCount == 0 || groupSize == 0)
+                {
+                    return;
+                }
+
+                // The continuation itself is tracked by ctx and only finishes after it has dispatched the groups,
+                // so ctx can't drop to zero in between
+                Context* target = &ctx;
+                Internal::Track(target, 1);
+                Internal::AddContinuation(dependency, Internal::CreateJob(target, [target, jobCount, groupSize, job]()
+                {
+                    Internal::Dispatch(target, jobCount, groupSize, job);
+                }));
+            }
 
             // Check if any threads are working currently or not
             bool IsBusy();
 
-            // Wait until all threads become idle
+            // Check if any job of ctx is still pending
+            bool IsBusy(const Context& ctx);
+
+            // Wait until all threads become idle.
+            // The calling thread runs pending jobs meanwhile, and sleeps when none are left to pick up.
             void Wait();
+
+            // Wait until every job of ctx, including its continuations, has finished.
+            // Helps out like Wait, which may mean running jobs that belong to other contexts.
+            void WaitFor(Context& ctx);
+
+            // Run func(chunkBegin, chunkEnd) over sub ranges of [begin, end) in parallel. Part of the range may run on the calling thread.
+            // Chunks are sized from the measured cost per item of this call site, ranges too cheap to be worth waking workers run inline.
+            // The remaining jobs are tracked by ctx. func is copied into every job, keep its captures small.
+            template <typename F>
+            void ParallelForChunked(Context& ctx, uint32_t begin, uint32_t end, const F& func)
+            {
+                if (end <= begin)
+                {
+                    return;
+                }
+
+                static Internal::ItemCost cost { 0.0f };
+
+                if (cost.load(std::memory_order_relaxed) == 0.0f)
+                {
+                    // First run of this call site, time a few items here
+                    const uint32_t probeEnd = begin + std::min(end - begin, JOB_PARALLEL_FOR_PROBE_SIZE);
+                    Internal::RunChunk(func, begin, probeEnd, &cost);
+
+                    begin = probeEnd;
+                    if (begin == end)
+                    {
+                        return;
+                    }
+                }
+
+                const uint32_t count = end - begin;
+                const float itemCost = cost.load(std::memory_order_relaxed);
+
+                if (GetThreadCount() == 0 || itemCost * static_cast<float>(count) < JOB_PARALLEL_FOR_INLINE_NS)
+                {
+                    Internal::RunChunk(func, begin, end, &cost);
+                    return;
+                }
+
+                const uint32_t grain = static_cast<uint32_t>(std::min(std::max(JOB_PARALLEL_FOR_CHUNK_NS / itemCost, 1.0f), static_cast<float>(count)));
+                Internal::SplitRange(&ctx, func, begin, end, grain, &cost);
+            }
+
+            // Same as above, but returns once the whole range has been processed
+            template <typename F>
+            void ParallelForChunked(uint32_t begin, uint32_t end, const F& func)
+            {
+                Context ctx;
+                ParallelForChunked(ctx, begin, end, func);
+                WaitFor(ctx);
+            }
+
+            // Run func(index) for every index of [begin, end) in parallel, see ParallelForChunked
+            template <typename F>
+            void ParallelFor(Context& ctx, uint32_t begin, uint32_t end, const F& func)
+            {
+                ParallelForChunked(ctx, begin, end, [func](uint32_t chunkBegin, uint32_t chunkEnd)
+                {
+                    for (uint32_t i = chunkBegin; i < chunkEnd; ++i)
+                        func(i);
+                });
+            }
+
+            template <typename F>
+            void ParallelFor(uint32_t begin, uint32_t end, const F& func)
+            {
+                Context ctx;
+                ParallelFor(ctx, begin, end, func);
+                WaitFor(ctx);
+            }
         }
     }
 }
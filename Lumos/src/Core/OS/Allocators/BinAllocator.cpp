@@ -1,69 +1,268 @@
 #include "lmpch.h"
 #include "BinAllocator.h"
+#include "Core/OS/Memory.h"
 
 namespace Lumos
 {
-	void* BinAllocator::Malloc(size_t size, const char* file, int line)
+	namespace
 	{
-		int bin = BinForSize(size);
-		if (m_Bins[bin] == nullptr)
-			 MakeChunk(size);
-		if (m_Bins[bin] == nullptr)
-			return nullptr;
-		void * result = m_Bins[bin];
-		m_Bins[bin] = *(void **)result;
-		return result;
+		// Guards allocator slots and the cache lists, taken only when a thread first uses an allocator,
+		// when a thread exits and when an allocator is destroyed
+		std::mutex s_RegistryLock;
+		BinAllocator* s_Allocators[BIN_MAX_ALLOCATORS] = {};
+		u64 s_NextSerial = 1;
+
+		struct ThreadCaches
+		{
+			BinAllocator::ThreadCache* caches[BIN_MAX_ALLOCATORS] = {};
+
+			~ThreadCaches()
+			{
+				std::lock_guard<std::mutex> lock(s_RegistryLock);
+				for (auto cache : caches)
+				{
+					if (cache == nullptr)
+						continue;
+
+					if (cache->owner)
+						cache->owner->ReleaseCache(cache);
+
+					free(cache);
+				}
+			}
+		};
+
+		thread_local ThreadCaches t_Caches;
 	}
 
-	void BinAllocator::Free(void * location)
+	BinAllocator::BinAllocator()
+		: m_RegionCount(0)
 	{
-		int bin = BinForLocation(location);
-		*(void**)location = m_Bins[bin];
-		m_Bins[bin] = location;
+		for (auto& region : m_Regions)
+			region.store(nullptr, std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(s_RegistryLock);
+		m_Serial = s_NextSerial++;
+		m_Slot = BIN_MAX_ALLOCATORS;
+		for (u32 i = 0; i < BIN_MAX_ALLOCATORS; ++i)
+		{
+			if (s_Allocators[i] == nullptr)
+			{
+				s_Allocators[i] = this;
+				m_Slot = i;
+				break;
+			}
+		}
+
+		LUMOS_ASSERT(m_Slot < BIN_MAX_ALLOCATORS, "Too many BinAllocators alive");
 	}
-	
-	void* BinAllocator::Chunk(int num)
+
+	BinAllocator::~BinAllocator()
 	{
-		return num * BIN_SIZE + sizeof(BinAllocator) + (char*)this;
+		{
+			// Caches of threads still running are deleted when those threads exit
+			std::lock_guard<std::mutex> lock(s_RegistryLock);
+			for (ThreadCache* cache = m_Caches; cache; cache = cache->next)
+				cache->owner = nullptr;
+			m_Caches = nullptr;
+			s_Allocators[m_Slot] = nullptr;
+		}
+
+		for (u32 i = 0; i < m_RegionCount.load(std::memory_order_relaxed); ++i)
+			Memory::AlignedFree(m_Regions[i].load(std::memory_order_relaxed));
 	}
 
-	int BinAllocator::ChunkIndex(void * loc)
+	void* BinAllocator::Malloc(size_t size, const char* file, int line)
 	{
-		return (int)((char*)loc - sizeof(BinAllocator) - (char *)this) / BIN_SIZE;
+		if (size > SizeForBin(NUM_BINS - 1))
+			return malloc(size);
+
+		const int bin = BinForSize(size);
+		ThreadCache* cache = GetThreadCache();
+
+		if (cache->bins[bin] == nullptr)
+		{
+			Refill(cache, bin);
+
+			// Out of regions
+			if (cache->bins[bin] == nullptr)
+				return malloc(size);
+		}
+
+		FreeBlock* block = cache->bins[bin];
+		cache->bins[bin] = block->next;
+		--cache->counts[bin];
+		return block;
 	}
 
-	int BinAllocator::BinForSize(size_t size)
+	void BinAllocator::Free(void* location)
 	{
-		return (int)((size - 1) / BIN_SIZE_INC);
+		if (location == nullptr)
+			return;
+
+		if (!Owns(location))
+		{
+			free(location);
+			return;
+		}
+
+		PageHeader* page = reinterpret_cast<PageHeader*>(reinterpret_cast<uintptr_t>(location) & ~(uintptr_t)(BIN_PAGE_SIZE - 1));
+		const int bin = static_cast<int>(page->bin);
+
+		ThreadCache* cache = GetThreadCache();
+		FreeBlock* block = static_cast<FreeBlock*>(location);
+		block->next = cache->bins[bin];
+		cache->bins[bin] = block;
+
+		if (++cache->counts[bin] >= BIN_BATCH_SIZE * 2)
+			Return(cache, bin, BIN_BATCH_SIZE);
 	}
 
-	size_t BinAllocator::SizeForBin(int bin)
+	void BinAllocator::Print()
 	{
-		return (bin + 1)* BIN_SIZE_INC;
+		Debug::Log::Info("BinAllocator : {0} regions, {1} pages of {2} bytes in use", GetRegionCount(), m_PagesUsed + (GetRegionCount() > 0 ? (GetRegionCount() - 1) * (MEMORY_SIZE / BIN_PAGE_SIZE) : 0), BIN_PAGE_SIZE);
+	}
+
+	void BinAllocator::ReleaseCache(ThreadCache* cache)
+	{
+		for (int bin = 0; bin < NUM_BINS; ++bin)
+			Return(cache, bin, cache->counts[bin]);
+
+		ThreadCache** link = &m_Caches;
+		while (*link != cache)
+			link = &(*link)->next;
+		*link = cache->next;
+		cache->owner = nullptr;
 	}
 
-	int BinAllocator::BinForLocation(void * location)
+	BinAllocator::ThreadCache* BinAllocator::GetThreadCache()
 	{
-		int index = ChunkIndex(location);
-		void* chunkStart = Chunk(index);
-		return *(int*)chunkStart;
+		ThreadCache*& cache = t_Caches.caches[m_Slot];
+		if (cache && cache->serial == m_Serial)
+			return cache;
+
+		std::lock_guard<std::mutex> lock(s_RegistryLock);
+
+		// Left over from a destroyed allocator that had the same slot
+		if (cache)
+			free(cache);
+
+		// Not from the heap, this may be the allocator behind operator new
+		cache = static_cast<ThreadCache*>(malloc(sizeof(ThreadCache)));
+		memset(cache, 0, sizeof(ThreadCache));
+		cache->owner = this;
+		cache->serial = m_Serial;
+		cache->next = m_Caches;
+		m_Caches = cache;
+
+		return cache;
 	}
 
-	void BinAllocator::MakeChunk(size_t size)
+	void BinAllocator::Refill(ThreadCache* cache, int bin)
 	{
-		if ((m_Max + 2)* BIN_SIZE + sizeof(BinAllocator) > MEMORY_SIZE) 
+		CentralBin& central = m_Bins[bin];
+		std::lock_guard<std::mutex> lock(central.lock);
+
+		if (central.head == nullptr && !NewPage(bin))
 			return;
 
-		int bin = BinForSize(size);
-		size_t actualSize = SizeForBin(bin);
-		
-		char* chunkPtr = (char*)Chunk(m_Max++);
-		*(int*)chunkPtr = bin;
-		chunkPtr += actualSize;
-		
-		 while (chunkPtr + actualSize <= Chunk(m_Max))
-		 {
-			 free(chunkPtr);
-		 }
+		u32 moved = 0;
+		while (central.head && moved < BIN_BATCH_SIZE)
+		{
+			FreeBlock* block = central.head;
+			central.head = block->next;
+
+			block->next = cache->bins[bin];
+			cache->bins[bin] = block;
+			++moved;
+		}
+
+		central.count -= moved;
+		cache->counts[bin] += moved;
+	}
+
+	void BinAllocator::Return(ThreadCache* cache, int bin, u32 count)
+	{
+		if (count == 0)
+			return;
+
+		// Detach count blocks from the cache first, then splice them into the shared bin in one go
+		FreeBlock* first = cache->bins[bin];
+		FreeBlock* last = first;
+		for (u32 i = 1; i < count; ++i)
+			last = last->next;
+
+		cache->bins[bin] = last->next;
+		cache->counts[bin] -= count;
+
+		CentralBin& central = m_Bins[bin];
+		std::lock_guard<std::mutex> lock(central.lock);
+		last->next = central.head;
+		central.head = first;
+		central.count += count;
+	}
+
+	bool BinAllocator::NewPage(int bin)
+	{
+		u8* page = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_RegionLock);
+
+			u32 regionCount = m_RegionCount.load(std::memory_order_relaxed);
+			if (regionCount == 0 || m_PagesUsed == MEMORY_SIZE / BIN_PAGE_SIZE)
+			{
+				if (regionCount == BIN_MAX_REGIONS)
+					return false;
+
+				u8* region = static_cast<u8*>(Memory::AlignedAlloc(MEMORY_SIZE, BIN_PAGE_SIZE));
+				if (region == nullptr)
+					return false;
+
+				m_Regions[regionCount].store(region, std::memory_order_relaxed);
+				m_RegionCount.store(++regionCount, std::memory_order_release);
+				m_PagesUsed = 0;
+			}
+
+			page = m_Regions[regionCount - 1].load(std::memory_order_relaxed) + m_PagesUsed++ * BIN_PAGE_SIZE;
+		}
+
+		reinterpret_cast<PageHeader*>(page)->bin = static_cast<u32>(bin);
+
+		// Caller holds the bin's lock
+		CentralBin& central = m_Bins[bin];
+		const size_t blockSize = SizeForBin(bin);
+		for (u8* block = page + sizeof(PageHeader); block + blockSize <= page + BIN_PAGE_SIZE; block += blockSize)
+		{
+			FreeBlock* freeBlock = reinterpret_cast<FreeBlock*>(block);
+			freeBlock->next = central.head;
+			central.head = freeBlock;
+			++central.count;
+		}
+
+		return true;
+	}
+
+	bool BinAllocator::Owns(void* location) const
+	{
+		const u8* address = static_cast<const u8*>(location);
+		const u32 regionCount = m_RegionCount.load(std::memory_order_acquire);
+		for (u32 i = 0; i < regionCount; ++i)
+		{
+			const u8* region = m_Regions[i].load(std::memory_order_relaxed);
+			if (address >= region && address < region + MEMORY_SIZE)
+				return true;
+		}
+
+		return false;
+	}
+
+	int BinAllocator::BinForSize(size_t size)
+	{
+		return size == 0 ? 0 : (int)((size - 1) / BIN_SIZE_INC);
+	}
+
+	size_t BinAllocator::SizeForBin(int bin)
+	{
+		return (bin + 1)* BIN_SIZE_INC;
 	}
-}
\ No newline at end of file
+}
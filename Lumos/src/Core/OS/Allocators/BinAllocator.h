@@ -1,45 +1,85 @@
 #pragma once
 #include "Allocator.h"
 
-#define MEMORY_SIZE 10*1024*1024
-#define BIN_SIZE 1024
+#define MEMORY_SIZE (10*1024*1024)
+#define BIN_PAGE_SIZE (64*1024)
 #define NUM_BINS 128
 #define BIN_SIZE_INC 16
+#define BIN_BATCH_SIZE 32
+#define BIN_MAX_REGIONS 64
+#define BIN_MAX_ALLOCATORS 8
 
 namespace Lumos
 {
+	// Size class allocator for blocks up to NUM_BINS * BIN_SIZE_INC bytes, larger ones go to malloc.
+	// Every thread keeps its own free list per bin and only touches the shared bins to refill or
+	// return BIN_BATCH_SIZE blocks at once. Blocks may be freed from any thread, they join the freeing thread's cache.
+	// Memory comes in regions of MEMORY_SIZE split into BIN_PAGE_SIZE pages, each page serving a single bin.
 	class LUMOS_HIDDEN BinAllocator : public Allocator
 	{
 	public:
-		BinAllocator() : m_Max(0)
-		{
-			for (int i = 0; i < NUM_BINS; i++)
-				m_Bins[i] = nullptr;
-		}
+		BinAllocator();
+		~BinAllocator();
 
-		~BinAllocator() = default;
+		NONCOPYABLE(BinAllocator)
 
 		void* Malloc(size_t size, const char* file, int line) override;
 		void Free(void* location) override;
+		void Print() override;
+
+		u32 GetRegionCount() const { return m_RegionCount.load(std::memory_order_acquire); }
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
 
-		void* operator new (size_t size) 
+		struct ThreadCache
 		{
-			return ::malloc(MEMORY_SIZE);		}
+			BinAllocator* owner;
+			u64 serial;
+			ThreadCache* next;
+			FreeBlock* bins[NUM_BINS];
+			u32 counts[NUM_BINS];
+		};
+
+		// Hands a thread's cached blocks back to the shared bins
+		void ReleaseCache(ThreadCache* cache);
+
 	private:
-		
-		BinAllocator(const BinAllocator& other) {};		BinAllocator operator =(const BinAllocator & other)
+		struct CentralBin
 		{
-			return *this;		}
-		void* Chunk(int num);
-		int ChunkIndex(void* loc);
-		int BinForSize(size_t size);
-		size_t SizeForBin(int bin);
-		int BinForLocation(void * location);
-		void MakeChunk(size_t size);
-		
-		int m_Max;
-		void* m_Bins[NUM_BINS];
-	};
+			std::mutex lock;
+			FreeBlock* head = nullptr;
+			u32 count = 0;
+		};
 
-}
+		struct PageHeader
+		{
+			u32 bin;
+			u32 padding[3];
+		};
+
+		ThreadCache* GetThreadCache();
+		void Refill(ThreadCache* cache, int bin);
+		void Return(ThreadCache* cache, int bin, u32 count);
+		bool NewPage(int bin);
+		bool Owns(void* location) const;
+
+		static int BinForSize(size_t size);
+		static size_t SizeForBin(int bin);
+
+		u64 m_Serial;
+		u32 m_Slot;
 
+		CentralBin m_Bins[NUM_BINS];
+
+		std::mutex m_RegionLock;
+		std::atomic<u8*> m_Regions[BIN_MAX_REGIONS];
+		std::atomic<u32> m_RegionCount;
+		u32 m_PagesUsed = 0;
+
+		// Caches of every thread that used this allocator, guarded by the registry lock
+		ThreadCache* m_Caches = nullptr;
+	};
+}
@@ -0,0 +1,102 @@
+#include "lmpch.h"
+#include "FrameAllocator.h"
+#include "LinearAllocator.h"
+#include "Core/OS/MemoryManager.h"
+
+namespace Lumos
+{
+	namespace
+	{
+		struct ThreadArena;
+
+		std::atomic<u64> s_FrameIndex(0);
+		std::mutex s_ArenaLock;
+		std::vector<ThreadArena*> s_Arenas;
+		size_t s_LastFrameBytes = 0;
+		size_t s_PeakFrameBytes = 0;
+
+		struct ThreadArena
+		{
+			LinearAllocator buffers[2];
+			u64 frame = ~0ull;
+
+			// Read by OnFrameEnd on the main thread
+			std::atomic<u64> usedFrame;
+			std::atomic<size_t> used;
+
+			ThreadArena()
+				: usedFrame(~0ull), used(0)
+			{
+				std::lock_guard<std::mutex> lock(s_ArenaLock);
+				s_Arenas.push_back(this);
+			}
+
+			~ThreadArena()
+			{
+				std::lock_guard<std::mutex> lock(s_ArenaLock);
+				s_Arenas.erase(std::find(s_Arenas.begin(), s_Arenas.end(), this));
+			}
+		};
+
+		thread_local ThreadArena t_Arena;
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		ThreadArena& arena = t_Arena;
+		const u64 frame = s_FrameIndex.load(std::memory_order_acquire);
+		LinearAllocator& buffer = arena.buffers[frame & 1];
+
+		if (arena.frame != frame)
+		{
+			// This buffer was last used two or more frames ago, nothing can still refer to it
+			buffer.Reset();
+			arena.frame = frame;
+		}
+
+		void* result = buffer.Allocate(size, alignment);
+
+		arena.used.store(buffer.GetUsed(), std::memory_order_relaxed);
+		arena.usedFrame.store(frame, std::memory_order_relaxed);
+
+		return result;
+	}
+
+	void FrameAllocator::OnFrameEnd()
+	{
+		const u64 frame = s_FrameIndex.load(std::memory_order_relaxed);
+
+		size_t total = 0;
+		{
+			std::lock_guard<std::mutex> lock(s_ArenaLock);
+			for (auto arena : s_Arenas)
+			{
+				if (arena->usedFrame.load(std::memory_order_relaxed) == frame)
+					total += arena->used.load(std::memory_order_relaxed);
+			}
+		}
+
+		s_LastFrameBytes = total;
+		s_PeakFrameBytes = std::max(s_PeakFrameBytes, total);
+
+		MemoryManager::Get()->m_MemoryStats.frameAllocated = static_cast<i64>(s_LastFrameBytes);
+		MemoryManager::Get()->m_MemoryStats.peakFrameAllocated = static_cast<i64>(s_PeakFrameBytes);
+
+		s_FrameIndex.store(frame + 1, std::memory_order_release);
+	}
+
+	u64 FrameAllocator::GetFrameIndex()
+	{
+		return s_FrameIndex.load(std::memory_order_relaxed);
+	}
+
+	size_t FrameAllocator::GetLastFrameBytes()
+	{
+		return s_LastFrameBytes;
+	}
+
+	size_t FrameAllocator::GetPeakFrameBytes()
+	{
+		return s_PeakFrameBytes;
+	}
+}
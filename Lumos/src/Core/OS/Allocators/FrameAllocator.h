@@ -0,0 +1,54 @@
+#pragma once
+#include "lmpch.h"
+
+namespace Lumos
+{
+	// Per frame scratch memory. Every thread bumps through its own pair of linear buffers, one for the
+	// current frame and one still holding the previous frame's data, so allocations stay valid until the end
+	// of the next frame and are never freed individually. Destructors are not run.
+	class FrameAllocator
+	{
+	public:
+		static void* Allocate(size_t size, size_t alignment = MEM_ALIGNMENT);
+
+		template <typename T>
+		static T* AllocateArray(size_t count)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T) > MEM_ALIGNMENT ? alignof(T) : MEM_ALIGNMENT));
+		}
+
+		// Starts the next frame, called once at the end of every frame. Thread buffers are reset lazily on their next use.
+		static void OnFrameEnd();
+
+		static u64 GetFrameIndex();
+
+		// Bytes allocated by all threads over the last frame, and the highest of any frame so far
+		static size_t GetLastFrameBytes();
+		static size_t GetPeakFrameBytes();
+	};
+
+	// STL allocator living in the frame allocator, for temporaries that don't outlive the next frame
+	template <typename T>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameStlAllocator() = default;
+
+		template <typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+		T* allocate(size_t count) { return FrameAllocator::AllocateArray<T>(count); }
+		void deallocate(T*, size_t) {}
+
+		template <typename U>
+		bool operator==(const FrameStlAllocator<U>&) const { return true; }
+
+		template <typename U>
+		bool operator!=(const FrameStlAllocator<U>&) const { return false; }
+	};
+
+	template <typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+}
@@ -0,0 +1,79 @@
+#include "lmpch.h"
+#include "LinearAllocator.h"
+#include "Core/OS/Memory.h"
+
+namespace Lumos
+{
+	LinearAllocator::LinearAllocator(size_t blockSize)
+		: m_BlockSize(blockSize)
+	{
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		ReleaseBlocks();
+	}
+
+	void* LinearAllocator::Malloc(size_t size, const char * file, int line)
+	{
+		return Allocate(size);
+	}
+
+	void* LinearAllocator::Allocate(size_t size, size_t alignment)
+	{
+		u8* result = (u8*)(((uintptr_t)m_Head + alignment - 1) & ~(uintptr_t)(alignment - 1));
+
+		if (m_Current == nullptr || result + size > m_End)
+		{
+			AddBlock(std::max(m_BlockSize, size + alignment));
+			result = (u8*)(((uintptr_t)m_Head + alignment - 1) & ~(uintptr_t)(alignment - 1));
+		}
+
+		m_Used += size;
+		m_Head = result + size;
+		return result;
+	}
+
+	void LinearAllocator::Reset()
+	{
+		if (m_Current && m_Current->previous)
+		{
+			// Overflowed into more than one block, replace them with a single one big enough for all of it
+			const size_t capacity = m_Capacity;
+			ReleaseBlocks();
+			AddBlock(capacity);
+		}
+		else if (m_Current)
+		{
+			m_Head = (u8*)(m_Current + 1);
+		}
+
+		m_Used = 0;
+	}
+
+	void LinearAllocator::AddBlock(size_t size)
+	{
+		Block* block = (Block*)Memory::AlignedAlloc(sizeof(Block) + size, MEM_ALIGNMENT);
+		block->previous = m_Current;
+		block->size = size;
+
+		m_Current = block;
+		m_Head = (u8*)(block + 1);
+		m_End = m_Head + size;
+		m_Capacity += size;
+	}
+
+	void LinearAllocator::ReleaseBlocks()
+	{
+		while (m_Current)
+		{
+			Block* previous = m_Current->previous;
+			Memory::AlignedFree(m_Current);
+			m_Current = previous;
+		}
+
+		m_Head = nullptr;
+		m_End = nullptr;
+		m_Capacity = 0;
+	}
+}
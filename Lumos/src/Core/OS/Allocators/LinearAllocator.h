@@ -0,0 +1,44 @@
+#pragma once
+#include "lmpch.h"
+#include "Allocator.h"
+
+namespace Lumos
+{
+	// Bump allocator. Individual frees are ignored, everything is released at once by Reset.
+	// Grows by chaining blocks, after a Reset the blocks are merged so the next round fits in one.
+	class LinearAllocator : public Allocator
+	{
+	public:
+		explicit LinearAllocator(size_t blockSize = 1024 * 1024);
+		~LinearAllocator();
+
+		NONCOPYABLE(LinearAllocator)
+
+		void* Malloc(size_t size, const char *file, int line) override;
+		void Free(void* location) override {}
+
+		void* Allocate(size_t size, size_t alignment = MEM_ALIGNMENT);
+		void Reset();
+
+		// Bytes handed out since the last Reset
+		size_t GetUsed() const { return m_Used; }
+		size_t GetCapacity() const { return m_Capacity; }
+
+	private:
+		struct Block
+		{
+			Block* previous;
+			size_t size;
+		};
+
+		void AddBlock(size_t size);
+		void ReleaseBlocks();
+
+		size_t m_BlockSize;
+		Block* m_Current = nullptr;
+		u8* m_Head = nullptr;
+		u8* m_End = nullptr;
+		size_t m_Used = 0;
+		size_t m_Capacity = 0;
+	};
+}
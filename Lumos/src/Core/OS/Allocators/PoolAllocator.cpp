@@ -0,0 +1,84 @@
+#include "lmpch.h"
+#include "PoolAllocator.h"
+#include "Core/OS/Memory.h"
+
+namespace Lumos
+{
+	PoolAllocator::PoolAllocator(size_t elementSize, size_t alignment, size_t elementsPerBlock)
+		: m_Alignment(alignment)
+		, m_ElementsPerBlock(elementsPerBlock)
+	{
+		// Free elements store the list link in place
+		m_ElementSize = std::max(elementSize, sizeof(FreeElement));
+		m_ElementSize = (m_ElementSize + alignment - 1) & ~(alignment - 1);
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		LUMOS_ASSERT(m_LiveCount == 0, "PoolAllocator destroyed with live elements");
+
+		for (auto block : m_Blocks)
+			Memory::AlignedFree(block);
+	}
+
+	void* PoolAllocator::Malloc(size_t size, const char * file, int line)
+	{
+		// Handing out an element anyway would let the caller write past it into its neighbour
+		if (size > m_ElementSize)
+		{
+			LUMOS_LOG_ERROR("PoolAllocator : {0} bytes requested from a pool of {1} byte elements", size, m_ElementSize);
+			return nullptr;
+		}
+
+		return Allocate();
+	}
+
+	void* PoolAllocator::Allocate()
+	{
+		Lock();
+
+		if (m_FreeList == nullptr)
+			Grow();
+
+		FreeElement* element = m_FreeList;
+		m_FreeList = element->next;
+		++m_LiveCount;
+
+		Unlock();
+		return element;
+	}
+
+	void PoolAllocator::Free(void* location)
+	{
+		if (location == nullptr)
+			return;
+
+		Lock();
+
+		FreeElement* element = static_cast<FreeElement*>(location);
+		element->next = m_FreeList;
+		m_FreeList = element;
+		--m_LiveCount;
+
+		Unlock();
+	}
+
+	void PoolAllocator::Print()
+	{
+		Debug::Log::Info("PoolAllocator : {0} / {1} elements of {2} bytes", m_LiveCount, GetCapacity(), m_ElementSize);
+	}
+
+	void PoolAllocator::Grow()
+	{
+		u8* block = static_cast<u8*>(Memory::AlignedAlloc(m_ElementSize * m_ElementsPerBlock, m_Alignment));
+		m_Blocks.push_back(block);
+
+		// Link back to front so elements are handed out in address order
+		for (size_t i = m_ElementsPerBlock; i > 0; --i)
+		{
+			FreeElement* element = reinterpret_cast<FreeElement*>(block + (i - 1) * m_ElementSize);
+			element->next = m_FreeList;
+			m_FreeList = element;
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include "lmpch.h"
+#include "Allocator.h"
+
+namespace Lumos
+{
+	// Fixed size elements handed out from a free list. Thread safe.
+	// Grows a block of elements at a time, memory is only returned to the system on destruction.
+	class PoolAllocator : public Allocator
+	{
+	public:
+		PoolAllocator(size_t elementSize, size_t alignment = MEM_ALIGNMENT, size_t elementsPerBlock = 256);
+		~PoolAllocator();
+
+		NONCOPYABLE(PoolAllocator)
+
+		void* Malloc(size_t size, const char *file, int line) override;
+		void Free(void* location) override;
+		void Print() override;
+
+		void* Allocate();
+
+		size_t GetElementSize() const { return m_ElementSize; }
+		size_t GetLiveCount() const { return m_LiveCount; }
+		size_t GetCapacity() const { return m_Blocks.size() * m_ElementsPerBlock; }
+
+	private:
+		struct FreeElement
+		{
+			FreeElement* next;
+		};
+
+		void Grow();
+
+		// Held for a handful of instructions, spinning is cheaper than a mutex here
+		void Lock()
+		{
+			while (m_Lock.test_and_set(std::memory_order_acquire))
+				std::this_thread::yield();
+		}
+
+		void Unlock() { m_Lock.clear(std::memory_order_release); }
+
+		size_t m_ElementSize;
+		size_t m_Alignment;
+		size_t m_ElementsPerBlock;
+
+		std::atomic_flag m_Lock = ATOMIC_FLAG_INIT;
+		FreeElement* m_FreeList = nullptr;
+		std::vector<void*> m_Blocks;
+		size_t m_LiveCount = 0;
+	};
+
+	// Typed pool constructing and destroying objects in place
+	template <typename T>
+	class ObjectPool
+	{
+	public:
+		explicit ObjectPool(size_t objectsPerBlock = 256)
+			: m_Allocator(sizeof(T), alignof(T) > MEM_ALIGNMENT ? alignof(T) : MEM_ALIGNMENT, objectsPerBlock)
+		{
+		}
+
+		NONCOPYABLE(ObjectPool)
+
+		template <typename... Args>
+		T* New(Args&&... args)
+		{
+			return new (m_Allocator.Allocate()) T(std::forward<Args>(args)...);
+		}
+
+		void Delete(T* object)
+		{
+			if (object == nullptr)
+				return;
+
+			object->~T();
+			m_Allocator.Free(object);
+		}
+
+		PoolAllocator& GetAllocator() { return m_Allocator; }
+
+		// Pool shared by everything allocating T
+		static ObjectPool& Get()
+		{
+			static ObjectPool pool;
+			return pool;
+		}
+
+	private:
+		PoolAllocator m_Allocator;
+	};
+
+	template <typename T>
+	struct PoolDeleter
+	{
+		ObjectPool<T>* pool = nullptr;
+
+		void operator()(T* object) const { pool->Delete(object); }
+	};
+
+	// Owning pointer returning its object to the pool it came from
+	template <typename T>
+	using PoolRef = std::unique_ptr<T, PoolDeleter<T>>;
+
+	template <typename T, typename... Args>
+	PoolRef<T> CreatePoolRef(Args&&... args)
+	{
+		ObjectPool<T>& pool = ObjectPool<T>::Get();
+		return PoolRef<T>(pool.New(std::forward<Args>(args)...), PoolDeleter<T>{ &pool });
+	}
+}
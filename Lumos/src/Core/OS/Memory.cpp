@@ -3,9 +3,29 @@
 #include "Allocators/BinAllocator.h"
 #include "Allocators/DefaultAllocator.h"
 #include "Allocators/StbAllocator.h"
+#include "MemoryManager.h"
 
 namespace Lumos
 {
+	namespace
+	{
+		thread_local MemoryTag t_CurrentTag = MemoryTag::General;
+
+#ifdef LUMOS_MEMORY_TRACKING
+		// Stored in front of every tracked allocation so the delete side knows what to account it to
+		struct AllocationHeader
+		{
+			size_t size;
+			u32 offset; // From the start of the underlying block to the returned pointer
+			MemoryTag tag;
+		};
+
+		// Keeps the returned block as aligned as the allocator's
+		const size_t AllocationHeaderSize = 16;
+		static_assert(sizeof(AllocationHeader) <= AllocationHeaderSize, "AllocationHeader too large");
+#endif
+	}
+
 	Allocator* const Memory::MemoryAllocator = new DefaultAllocator();
 
     void* Memory::AlignedAlloc(size_t size, size_t alignment)
@@ -32,19 +52,93 @@ namespace Lumos
     
     void* Memory::NewFunc(std::size_t size, const char *file, int line)
     {
-		if (MemoryAllocator)
-			return MemoryAllocator->Malloc(size, file, line);
-		else
-			return malloc(size);
+		return NewFunc(size, file, line, t_CurrentTag);
+    }
+
+    void* Memory::NewFunc(std::size_t size, const char *file, int line, MemoryTag tag)
+    {
+#ifdef LUMOS_MEMORY_TRACKING
+		size_t allocationSize = size + AllocationHeaderSize;
+#else
+		size_t allocationSize = size;
+#endif
+		u8* block = static_cast<u8*>(MemoryAllocator ? MemoryAllocator->Malloc(allocationSize, file, line) : malloc(allocationSize));
+
+#ifdef LUMOS_MEMORY_TRACKING
+		if (block == nullptr)
+			return nullptr;
+
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(block);
+		header->size = size;
+		header->offset = static_cast<u32>(AllocationHeaderSize);
+		header->tag = tag;
+		MemoryManager::TrackAllocation(tag, size);
+		block += AllocationHeaderSize;
+#endif
+		return block;
     }
     
     void Memory::DeleteFunc(void* p)
     {
+#ifdef LUMOS_MEMORY_TRACKING
+		if (p == nullptr)
+			return;
+
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(static_cast<u8*>(p) - AllocationHeaderSize);
+		MemoryManager::TrackFree(header->tag, header->size);
+		p = header;
+#endif
 		if (MemoryAllocator)
 			return MemoryAllocator->Free(p);
 		else
 			return free(p);
     }
+
+	void* Memory::AlignedNewFunc(std::size_t size, std::size_t alignment, const char *file, int line)
+	{
+#ifdef LUMOS_MEMORY_TRACKING
+		// The header sits right in front of the returned pointer, pad by a whole alignment to keep it aligned
+		const size_t offset = alignment > AllocationHeaderSize ? alignment : AllocationHeaderSize;
+		u8* block = static_cast<u8*>(AlignedAlloc(size + offset, alignment));
+		if (block == nullptr)
+			return nullptr;
+
+		block += offset;
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(block - AllocationHeaderSize);
+		header->size = size;
+		header->offset = static_cast<u32>(offset);
+		header->tag = t_CurrentTag;
+		MemoryManager::TrackAllocation(t_CurrentTag, size);
+		return block;
+#else
+		return AlignedAlloc(size, alignment);
+#endif
+	}
+
+	void Memory::AlignedDeleteFunc(void* p)
+	{
+#ifdef LUMOS_MEMORY_TRACKING
+		if (p == nullptr)
+			return;
+
+		AllocationHeader* header = reinterpret_cast<AllocationHeader*>(static_cast<u8*>(p) - AllocationHeaderSize);
+		MemoryManager::TrackFree(header->tag, header->size);
+		p = static_cast<u8*>(p) - header->offset;
+#endif
+		AlignedFree(p);
+	}
+
+	MemoryTag Memory::SetCurrentTag(MemoryTag tag)
+	{
+		MemoryTag previous = t_CurrentTag;
+		t_CurrentTag = tag;
+		return previous;
+	}
+
+	MemoryTag Memory::GetCurrentTag()
+	{
+		return t_CurrentTag;
+	}
     
     void Memory::LogMemoryInformation()
     {
@@ -109,6 +203,17 @@ void operator delete[](void *p) throw()
     Lumos::Memory::DeleteFunc(p);
 }
 
+// Sized deallocation has to come back through DeleteFunc as well, the size doesn't include the tracking header
+void operator delete(void* p, std::size_t size) noexcept
+{
+    Lumos::Memory::DeleteFunc(p);
+}
+
+void operator delete[](void* p, std::size_t size) noexcept
+{
+    Lumos::Memory::DeleteFunc(p);
+}
+
 void operator delete(void* block, const char* file, int line)
 {
     Lumos::Memory::DeleteFunc(block);
@@ -118,4 +223,105 @@ void operator delete[](void* block, const char* file, int line)
 {
     Lumos::Memory::DeleteFunc(block);
 }
+
+// Over-aligned types, used for anything declared alignas wider than the default new alignment
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    void* result = Lumos::Memory::AlignedNewFunc(size, static_cast<std::size_t>(alignment), __FILE__, __LINE__);
+    if (result == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    void* result = Lumos::Memory::AlignedNewFunc(size, static_cast<std::size_t>(alignment), __FILE__, __LINE__);
+    if (result == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const char *file, int line)
+{
+    void* result = Lumos::Memory::AlignedNewFunc(size, static_cast<std::size_t>(alignment), file, line);
+    if (result == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const char *file, int line)
+{
+    void* result = Lumos::Memory::AlignedNewFunc(size, static_cast<std::size_t>(alignment), file, line);
+    if (result == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void operator delete(void* p, std::align_val_t alignment) noexcept
+{
+    Lumos::Memory::AlignedDeleteFunc(p);
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept
+{
+    Lumos::Memory::AlignedDeleteFunc(p);
+}
+
+void operator delete(void* p, std::size_t size, std::align_val_t alignment) noexcept
+{
+    Lumos::Memory::AlignedDeleteFunc(p);
+}
+
+void operator delete[](void* p, std::size_t size, std::align_val_t alignment) noexcept
+{
+    Lumos::Memory::AlignedDeleteFunc(p);
+}
+
+void operator delete(void* p, std::align_val_t alignment, const char *file, int line)
+{
+    Lumos::Memory::AlignedDeleteFunc(p);
+}
+
+void operator delete[](void* p, std::align_val_t alignment, const char *file, int line)
+{
+    Lumos::Memory::AlignedDeleteFunc(p);
+}
+
+void* operator new(std::size_t size, const char *file, int line, Lumos::MemoryTag tag)
+{
+    void* result = Lumos::Memory::NewFunc(size, file, line, tag);
+    if (result == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void* operator new[](std::size_t size, const char *file, int line, Lumos::MemoryTag tag)
+{
+    void* result = Lumos::Memory::NewFunc(size, file, line, tag);
+    if (result == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void operator delete(void* block, const char* file, int line, Lumos::MemoryTag tag)
+{
+    Lumos::Memory::DeleteFunc(block);
+}
+
+void operator delete[](void* block, const char* file, int line, Lumos::MemoryTag tag)
+{
+    Lumos::Memory::DeleteFunc(block);
+}
 #endif
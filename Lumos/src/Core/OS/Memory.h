@@ -2,8 +2,26 @@
 #include "lmpch.h"
 #include "Allocators/Allocator.h"
 
+// Per subsystem allocation tracking, compiled out of Dist builds
+#if !defined(LUMOS_DIST)
+#define LUMOS_MEMORY_TRACKING
+#endif
+
 namespace Lumos
 {
+	// Subsystem an allocation is accounted to, see MemoryManager::GetTagStats
+	enum class MemoryTag : uint8_t
+	{
+		General,
+		Renderer,
+		Physics,
+		Assets,
+		Scripting,
+		Audio,
+		Editor,
+		Count
+	};
+
 	class Memory
 	{
 	public:
@@ -11,31 +29,76 @@ namespace Lumos
 		static void AlignedFree(void* data);
 
 		static void* NewFunc(std::size_t size, const char *file, int line);
+		static void* NewFunc(std::size_t size, const char *file, int line, MemoryTag tag);
 		static void DeleteFunc(void* p);
+		static void* AlignedNewFunc(std::size_t size, std::size_t alignment, const char *file, int line);
+		static void AlignedDeleteFunc(void* p);
 		static void LogMemoryInformation();
 
+		// Tag given to untagged allocations from the calling thread, returns the previous one
+		static MemoryTag SetCurrentTag(MemoryTag tag);
+		static MemoryTag GetCurrentTag();
+
 		static Allocator* const MemoryAllocator;
 	};
+
+	// Accounts untagged allocations made by this thread to tag until the end of the scope
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) : m_Previous(Memory::SetCurrentTag(tag)) {}
+		~MemoryTagScope() { Memory::SetCurrentTag(m_Previous); }
+
+		NONCOPYABLE(MemoryTagScope)
+
+	private:
+		MemoryTag m_Previous;
+	};
 }
 
+#ifdef LUMOS_MEMORY_TRACKING
+#define LUMOS_MEMORY_TAG(tag) Lumos::MemoryTagScope memoryTagScope(Lumos::MemoryTag::tag)
+#else
+#define LUMOS_MEMORY_TAG(tag)
+#endif
+
 #define CUSTOM_MEMORY_ALLOCATOR
 #if  defined(CUSTOM_MEMORY_ALLOCATOR) && defined(LUMOS_ENGINE)
 
 #define lmnew		new(__FILE__, __LINE__)
+#define lmnew_tagged(tag)	new(__FILE__, __LINE__, Lumos::MemoryTag::tag)
 #define lmdel		delete
 
 void* operator new(std::size_t size);
 void* operator new(std::size_t size, const char *file, int line);
 void* operator new[](std::size_t size, const char *file, int line);
+void* operator new(std::size_t size, const char *file, int line, Lumos::MemoryTag tag);
+void* operator new[](std::size_t size, const char *file, int line, Lumos::MemoryTag tag);
 void* operator new (std::size_t size, const std::nothrow_t& nothrow_value) noexcept;
 void* operator new[](std::size_t size);
 
 void operator delete(void * p) throw();
 void operator delete[](void *p) throw();
+void operator delete(void* p, std::size_t size) noexcept;
+void operator delete[](void* p, std::size_t size) noexcept;
+
+void* operator new(std::size_t size, std::align_val_t alignment);
+void* operator new[](std::size_t size, std::align_val_t alignment);
+void* operator new(std::size_t size, std::align_val_t alignment, const char *file, int line);
+void* operator new[](std::size_t size, std::align_val_t alignment, const char *file, int line);
+void operator delete(void* p, std::align_val_t alignment) noexcept;
+void operator delete[](void* p, std::align_val_t alignment) noexcept;
+void operator delete(void* p, std::size_t size, std::align_val_t alignment) noexcept;
+void operator delete[](void* p, std::size_t size, std::align_val_t alignment) noexcept;
+void operator delete(void* p, std::align_val_t alignment, const char *file, int line);
+void operator delete[](void* p, std::align_val_t alignment, const char *file, int line);
 void operator delete(void* block, const char* file, int line);
 void operator delete[](void* block, const char* file, int line);
+void operator delete(void* block, const char* file, int line, Lumos::MemoryTag tag);
+void operator delete[](void* block, const char* file, int line, Lumos::MemoryTag tag);
 
 #else
 #define lmnew new
+#define lmnew_tagged(tag) new
 #define lmdel delete
 #endif
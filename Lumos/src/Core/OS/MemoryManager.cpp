@@ -1,8 +1,34 @@
 #include "lmpch.h"
 #include "MemoryManager.h"
 #include <iomanip>   
+#include <atomic>
 namespace Lumos
 {
+		namespace
+		{
+			// Padded so threads allocating under different tags don't share a cache line
+			struct alignas(64) TagCounters
+			{
+				std::atomic<i64> currentUsed{ 0 };
+				std::atomic<i64> peakUsed{ 0 };
+				std::atomic<i64> totalAllocations{ 0 };
+				std::atomic<i64> frameAllocations{ 0 };
+				std::atomic<i64> frameAllocated{ 0 };
+
+				// Written by OnFrameEnd on the main thread
+				std::atomic<i64> lastFrameAllocations{ 0 };
+				std::atomic<i64> lastFrameAllocated{ 0 };
+				std::atomic<i64> budget{ 0 };
+				std::atomic<bool> overBudget{ false };
+			};
+
+			// Constant initialised, allocations made during static initialisation are counted too
+			TagCounters s_TagCounters[static_cast<int>(MemoryTag::Count)];
+
+			const char* const s_TagNames[] = { "General", "Renderer", "Physics", "Assets", "Scripting", "Audio", "Editor" };
+			static_assert(sizeof(s_TagNames) / sizeof(s_TagNames[0]) == static_cast<size_t>(MemoryTag::Count), "Missing MemoryTag name");
+		}
+
 		MemoryManager* MemoryManager::s_Instance = nullptr;
 
 		MemoryManager::MemoryManager()
@@ -15,8 +41,13 @@ namespace Lumos
 
 		void MemoryManager::OnShutdown()
 		{
-			if(s_Instance)
-				lmdel s_Instance;
+			// Created with malloc in Get, not through the tracked operator new
+			if (s_Instance)
+			{
+				s_Instance->~MemoryManager();
+				free(s_Instance);
+				s_Instance = nullptr;
+			}
 		}
 
 		MemoryManager* MemoryManager::Get()
@@ -29,6 +60,70 @@ namespace Lumos
 			return s_Instance;
 		}
 
+		void MemoryManager::TrackAllocation(MemoryTag tag, size_t size)
+		{
+			TagCounters& counters = s_TagCounters[static_cast<int>(tag)];
+			const i64 used = counters.currentUsed.fetch_add(static_cast<i64>(size), std::memory_order_relaxed) + static_cast<i64>(size);
+			counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+			counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+			counters.frameAllocated.fetch_add(static_cast<i64>(size), std::memory_order_relaxed);
+
+			i64 peak = counters.peakUsed.load(std::memory_order_relaxed);
+			while (used > peak && !counters.peakUsed.compare_exchange_weak(peak, used, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		void MemoryManager::TrackFree(MemoryTag tag, size_t size)
+		{
+			s_TagCounters[static_cast<int>(tag)].currentUsed.fetch_sub(static_cast<i64>(size), std::memory_order_relaxed);
+		}
+
+		MemoryTagStats MemoryManager::GetTagStats(MemoryTag tag)
+		{
+			const TagCounters& counters = s_TagCounters[static_cast<int>(tag)];
+
+			MemoryTagStats stats;
+			stats.currentUsed = counters.currentUsed.load(std::memory_order_relaxed);
+			stats.peakUsed = counters.peakUsed.load(std::memory_order_relaxed);
+			stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+			stats.frameAllocations = counters.lastFrameAllocations.load(std::memory_order_relaxed);
+			stats.frameAllocated = counters.lastFrameAllocated.load(std::memory_order_relaxed);
+			stats.budget = counters.budget.load(std::memory_order_relaxed);
+			stats.overBudget = counters.overBudget.load(std::memory_order_relaxed);
+			return stats;
+		}
+
+		const char* MemoryManager::GetTagName(MemoryTag tag)
+		{
+			return s_TagNames[static_cast<int>(tag)];
+		}
+
+		void MemoryManager::SetBudget(MemoryTag tag, i64 bytes)
+		{
+			s_TagCounters[static_cast<int>(tag)].budget.store(bytes, std::memory_order_relaxed);
+		}
+
+		void MemoryManager::OnFrameEnd()
+		{
+			for (int i = 0; i < static_cast<int>(MemoryTag::Count); ++i)
+			{
+				TagCounters& counters = s_TagCounters[i];
+				counters.lastFrameAllocations.store(counters.frameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+				counters.lastFrameAllocated.store(counters.frameAllocated.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+				const i64 budget = counters.budget.load(std::memory_order_relaxed);
+				const i64 used = counters.currentUsed.load(std::memory_order_relaxed);
+				const bool overBudget = budget > 0 && used > budget;
+
+				// Only warn when crossing, not every frame spent over
+				if (overBudget && !counters.overBudget.load(std::memory_order_relaxed))
+					LUMOS_LOG_WARN("{0} memory over budget : {1} / {2}", s_TagNames[i], BytesToString(used), BytesToString(budget));
+
+				counters.overBudget.store(overBudget, std::memory_order_relaxed);
+			}
+		}
+
 		String MemoryManager::BytesToString(i64 bytes)
 		{
 			static const float gb = 1024 * 1024 * 1024;
@@ -22,12 +22,31 @@ namespace Lumos
 			i64 currentUsed;
 			i64 totalAllocations;
 
+			// FrameAllocator bytes used in the last frame, and the most used in any frame
+			i64 frameAllocated;
+			i64 peakFrameAllocated;
+
 			MemoryStats()
-				: totalAllocated(0), totalFreed(0), currentUsed(0), totalAllocations(0)
+				: totalAllocated(0), totalFreed(0), currentUsed(0), totalAllocations(0), frameAllocated(0), peakFrameAllocated(0)
 			{
 			}
 		};
 
+		struct MemoryTagStats
+		{
+			i64 currentUsed;
+			i64 peakUsed;
+			i64 totalAllocations;
+
+			// Allocations made and bytes allocated during the last frame
+			i64 frameAllocations;
+			i64 frameAllocated;
+
+			// Zero when the tag has no budget
+			i64 budget;
+			bool overBudget;
+		};
+
 		class MemoryManager
 		{
 		public:
@@ -42,6 +61,19 @@ namespace Lumos
 
 			static MemoryManager* Get();
 			_FORCE_INLINE_ MemoryStats GetMemoryStats() const { return m_MemoryStats; }
+
+			// Called by Memory for every tracked allocation, safe from any thread and before static initialisation
+			static void TrackAllocation(MemoryTag tag, size_t size);
+			static void TrackFree(MemoryTag tag, size_t size);
+
+			static MemoryTagStats GetTagStats(MemoryTag tag);
+			static const char* GetTagName(MemoryTag tag);
+
+			// A warning is logged at the end of the first frame a tag's current usage goes over its budget, zero removes it
+			static void SetBudget(MemoryTag tag, i64 bytes);
+
+			// Rolls the per frame counters over and checks the budgets
+			static void OnFrameEnd();
 		public:
 			SystemMemoryInfo GetSystemInfo();
 		public:
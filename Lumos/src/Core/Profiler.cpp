@@ -1,37 +1,104 @@
 #include "lmpch.h"
 #include "Profiler.h"
+#include "Core/OS/FileSystem.h"
+
+#include <iomanip>
 
 namespace Lumos
 {
-#ifdef LUMOS_PROFILER_ENABLED
-	const char* ProfilerRecord::s_CurrentProfilerName = "";
-#endif
+    namespace
+    {
+        // Only taken when a thread records its first event and by Flush
+        std::mutex s_BufferLock;
+        std::vector<std::unique_ptr<ProfilerEventBuffer>> s_Buffers;
+
+        struct ThreadBuffer
+        {
+            ProfilerEventBuffer* buffer = nullptr;
+
+            ~ThreadBuffer()
+            {
+                if (buffer)
+                    buffer->Retired.store(true, std::memory_order_release);
+            }
+        };
+
+        thread_local ThreadBuffer t_Buffer;
+        thread_local const ProfilerRecord* t_CurrentRecord = nullptr;
+        thread_local String t_ThreadName;
+
+        ProfilerEventBuffer* GetThreadBuffer()
+        {
+            if (t_Buffer.buffer == nullptr)
+            {
+                auto buffer = std::make_unique<ProfilerEventBuffer>(std::this_thread::get_id());
+                buffer->ThreadName = t_ThreadName;
+                t_Buffer.buffer = buffer.get();
+
+                std::lock_guard<std::mutex> lock(s_BufferLock);
+                s_Buffers.push_back(std::move(buffer));
+            }
+            return t_Buffer.buffer;
+        }
+
+        void WriteJsonString(std::stringstream& stream, const String& text)
+        {
+            stream << '"';
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\')
+                    stream << '\\' << c;
+                else if (static_cast<unsigned char>(c) < 0x20)
+                    stream << ' ';
+                else
+                    stream << c;
+            }
+            stream << '"';
+        }
+    }
 
     ProfilerRecord::ProfilerRecord(const char* name)
         : m_Name(name)
+        , m_Parent(nullptr)
+        , m_Start(0)
+        , m_Depth(0)
+        , m_Active(Profiler::Instance()->IsEnabled())
     {
-#ifdef LUMOS_PROFILER_ENABLED
-		m_Parent = s_CurrentProfilerName;
-		s_CurrentProfilerName = name;
-#endif
-
-        m_EndTime = 0.0f;
+        if (m_Active)
+        {
+            m_Parent = t_CurrentRecord;
+            m_Depth = m_Parent ? m_Parent->m_Depth + 1 : 0;
+            t_CurrentRecord = this;
+            m_Start = Profiler::Now();
+        }
     }
     
     ProfilerRecord::~ProfilerRecord()
     {
-        m_EndTime = m_Timer.GetTimedMS();
-        Profiler::Instance()->Save(*this);
+        if (m_Active)
+        {
+            Profiler::Record(m_Name, m_Start, Profiler::Now(), m_Depth);
+            t_CurrentRecord = m_Parent;
+        }
+    }
 
-#ifdef LUMOS_PROFILER_ENABLED
-		s_CurrentProfilerName = m_Parent;
-#endif
+    const ProfilerRecord* ProfilerRecord::Current()
+    {
+        return t_CurrentRecord;
     }
     
     Profiler::Profiler()
     {
         m_ElapsedFrames = 0;
+        m_DroppedEvents = 0;
         m_Enabled = false;
+        m_CaptureFramesLeft = 0;
+        m_EnabledBeforeCapture = false;
+        m_SpikeThreshold = 0.0f;
+        m_MaxSpikes = 8;
+        m_FrameIndex = 0;
+        m_CallTreeWindow = 60;
+        m_CallTree.name = "Frame";
     }
     
     Profiler::~Profiler()
@@ -45,6 +112,30 @@ namespace Lumos
         {
             ++m_ElapsedFrames;
         }
+
+        Flush();
+
+        if (IsEnabled())
+        {
+            for (auto& thread : m_FrameCallTree.children)
+                MergeCallNode(m_CallTree.children, thread);
+            m_CallTree.calls++;
+
+            m_CallTreeHistory.push_back(std::move(m_FrameCallTree));
+            m_FrameCallTree = ProfilerCallNode();
+
+            SetCallTreeWindow(m_CallTreeWindow);
+        }
+
+        if (m_CaptureFramesLeft > 0)
+        {
+            m_Capture.frameEnds.push_back(Now());
+            if (--m_CaptureFramesLeft == 0)
+                EndCapture();
+        }
+
+        EndSpikeFrame();
+        ++m_FrameIndex;
     }
     
     void Profiler::ClearHistory()
@@ -80,32 +171,306 @@ namespace Lumos
 		Debug::Log::Info(m_Enabled ? "Profiler Enabled" : "Profiler Disabled");
     }
     
-    void Profiler::Save(const ProfilerRecord& record)
+    void Profiler::Record(const char* name, i64 start, i64 end, u32 depth)
     {
-        m_SaveMutex.lock();
-        
-        if (std::find(m_WorkingThreads.begin(), m_WorkingThreads.end(), std::this_thread::get_id()) == m_WorkingThreads.end())
-            m_WorkingThreads.push_back(std::this_thread::get_id());
-        
-        if (m_ElapsedHistory.find(record.Name()) != m_ElapsedHistory.end())
+        GetThreadBuffer()->Push({ name, start, end, depth });
+    }
+
+    void Profiler::Flush()
+    {
+        std::lock_guard<std::mutex> lock(s_BufferLock);
+
+        u32 dropped = 0;
+        for (auto it = s_Buffers.begin(); it != s_Buffers.end();)
+        {
+            ProfilerEventBuffer* buffer = it->get();
+
+            // Read before draining so nothing pushed after it is missed
+            const bool retired = buffer->Retired.load(std::memory_order_acquire);
+
+            if (buffer->ThreadName.empty())
+                buffer->ThreadName = "Thread " + std::to_string(m_ThreadNames.size());
+
+            const char* threadName = InternThreadName(buffer->ThreadName);
+            ProfilerCallNode* threadNode = nullptr;
+            for (auto& node : m_FrameCallTree.children)
+                if (node.name == threadName)
+                    threadNode = &node;
+            if (threadNode == nullptr)
+            {
+                m_FrameCallTree.children.emplace_back();
+                threadNode = &m_FrameCallTree.children.back();
+                threadNode->name = threadName;
+                threadNode->calls = 1;
+            }
+
+            const u32 captureThread = m_CaptureFramesLeft > 0 ? m_Capture.GetThreadIndex(buffer->GetThreadId(), buffer->ThreadName) : 0;
+            const u32 spikeThread = m_SpikeThreshold > 0.0f ? m_SpikeFrame.GetThreadIndex(buffer->GetThreadId(), buffer->ThreadName) : 0;
+
+            const u32 count = buffer->Drain([this, buffer, threadNode, captureThread, spikeThread](const ProfilerEvent& event)
+            {
+                const double duration = static_cast<double>(event.end - event.start) / 1000000.0;
+                m_ElapsedHistory[event.name] += static_cast<float>(duration);
+                ++m_CallsCounter[event.name];
+
+                // Events arrive as scopes end, so children come before their parent and are collected by it
+                auto& pending = buffer->PendingScopes;
+                if (pending.size() < event.depth + 2)
+                    pending.resize(event.depth + 2);
+
+                ProfilerCallNode node;
+                node.name = event.name;
+                node.inclusive = duration;
+                node.exclusive = duration;
+                node.calls = 1;
+                for (auto& child : pending[event.depth + 1])
+                {
+                    node.exclusive -= child.inclusive;
+                    MergeCallNode(node.children, child);
+                }
+                pending[event.depth + 1].clear();
+
+                if (event.depth == 0)
+                {
+                    threadNode->inclusive += node.inclusive;
+                    MergeCallNode(threadNode->children, node);
+                }
+                else
+                    pending[event.depth].push_back(std::move(node));
+
+                if (m_CaptureFramesLeft > 0 && event.start >= m_Capture.start)
+                    m_Capture.events.push_back({ event, captureThread });
+                if (m_SpikeThreshold > 0.0f && event.start >= m_SpikeFrame.start)
+                    m_SpikeFrame.events.push_back({ event, spikeThread });
+            });
+
+            if (count > 0 && std::find(m_WorkingThreads.begin(), m_WorkingThreads.end(), buffer->GetThreadId()) == m_WorkingThreads.end())
+                m_WorkingThreads.push_back(buffer->GetThreadId());
+
+            dropped += buffer->TakeDroppedCount();
+
+            if (retired)
+                it = s_Buffers.erase(it);
+            else
+                ++it;
+        }
+
+        if (dropped > 0)
+            Debug::Log::Warning("Profiler dropped {0} events, PROFILER_EVENT_BUFFER_SIZE is too small", dropped);
+        m_DroppedEvents += dropped;
+    }
+
+    void Profiler::CaptureFrames(u32 frameCount, const String& path)
+    {
+        if (frameCount == 0)
+            return;
+
+        if (m_CaptureFramesLeft == 0)
+            m_EnabledBeforeCapture = m_Enabled;
+
+        m_Enabled = true;
+        m_CaptureFramesLeft = frameCount;
+        m_CapturePath = path;
+        m_Capture.Clear();
+        m_Capture.start = Now();
+
+        Debug::Log::Info("Profiler capturing {0} frames to {1}", frameCount, path);
+    }
+
+    void Profiler::EndCapture()
+    {
+        m_Enabled = m_EnabledBeforeCapture;
+
+        if (FileSystem::WriteTextFile(m_CapturePath, ExportChromeTrace()))
+            Debug::Log::Info("Profiler capture of {0} events saved to {1}", m_Capture.events.size(), m_CapturePath);
+        else
+            Debug::Log::Error("Failed to save profiler capture to {0}", m_CapturePath);
+    }
+
+    void Profiler::SetSpikeThreshold(float milliseconds, u32 maxSpikes)
+    {
+        m_SpikeThreshold = std::max(milliseconds, 0.0f);
+        m_MaxSpikes = std::max(maxSpikes, 1u);
+
+        while (m_Spikes.size() > m_MaxSpikes)
+            m_Spikes.pop_front();
+
+        m_SpikeFrame.Clear();
+        m_SpikeFrame.start = Now();
+    }
+
+    void Profiler::EndSpikeFrame()
+    {
+        if (m_SpikeThreshold <= 0.0f)
+            return;
+
+        const i64 end = Now();
+        const float frameTime = static_cast<float>(end - m_SpikeFrame.start) / 1000000.0f;
+
+        if (frameTime > m_SpikeThreshold && !m_SpikeFrame.events.empty())
         {
-            m_ElapsedHistory[record.Name()] += record.EndTime();
+            Debug::Log::Warning("Frame {0} took {1} ms, kept {2} profiler events", m_FrameIndex, frameTime, m_SpikeFrame.events.size());
+
+            m_SpikeFrame.frameEnds.push_back(end);
+            m_Spikes.push_back({ m_FrameIndex, frameTime, m_SpikeFrame });
+            if (m_Spikes.size() > m_MaxSpikes)
+                m_Spikes.pop_front();
         }
+
+        // Cleared rather than reallocated so frames under the threshold cost no allocations
+        m_SpikeFrame.Clear();
+        m_SpikeFrame.start = end;
+    }
+
+    void Profiler::SetCounter(const char* name, double value)
+    {
+        auto counter = std::find_if(m_Counters.begin(), m_Counters.end(), [name](const ProfilerCounter& c) { return c.name == name; });
+        if (counter != m_Counters.end())
+            counter->value = value;
         else
+            m_Counters.push_back({ name, value });
+
+        if (m_CaptureFramesLeft > 0)
+            m_Capture.counters.push_back({ name, Now(), value });
+        if (m_SpikeThreshold > 0.0f)
+            m_SpikeFrame.counters.push_back({ name, Now(), value });
+    }
+
+    bool Profiler::SaveSpike(u32 index, const String& path) const
+    {
+        if (index >= m_Spikes.size())
+            return false;
+
+        return FileSystem::WriteTextFile(path, ExportChromeTrace(m_Spikes[index].trace));
+    }
+
+    String Profiler::ExportChromeTrace(const ProfilerTrace& trace)
+    {
+        std::stringstream json;
+        json << std::fixed << std::setprecision(3);
+        json << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+        // Timestamps and durations are in microseconds relative to the start of the capture
+        auto microseconds = [&trace](i64 time) { return static_cast<double>(time - trace.start) / 1000.0; };
+
+        bool first = true;
+        auto separator = [&json, &first]()
         {
-            m_ElapsedHistory[record.Name()] = record.EndTime();
+            if (!first)
+                json << ",";
+            first = false;
+        };
+
+        for (u32 i = 0; i < trace.threads.size(); ++i)
+        {
+            const String name = trace.threads[i].name.empty() ? "Thread " + std::to_string(i) : trace.threads[i].name;
+
+            separator();
+            json << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":";
+            WriteJsonString(json, name);
+            json << "}}";
         }
-        
-        if (m_CallsCounter.find(record.Name()) != m_CallsCounter.end())
+
+        for (size_t i = 0; i < trace.frameEnds.size(); ++i)
         {
-            ++m_CallsCounter[record.Name()];
+            separator();
+            json << "{\"name\":\"Frame " << i << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":" << microseconds(trace.frameEnds[i]) << "}";
         }
-        else
+
+        for (auto& captured : trace.events)
         {
-            m_CallsCounter[record.Name()] = 1;
+            separator();
+            json << "{\"name\":";
+            WriteJsonString(json, captured.event.name);
+            json << ",\"cat\":\"Lumos\",\"ph\":\"X\",\"pid\":0,\"tid\":" << captured.thread;
+            json << ",\"ts\":" << microseconds(captured.event.start);
+            json << ",\"dur\":" << static_cast<double>(captured.event.end - captured.event.start) / 1000.0 << "}";
         }
-        
-        m_SaveMutex.unlock();
+
+        for (auto& counter : trace.counters)
+        {
+            separator();
+            json << "{\"name\":";
+            WriteJsonString(json, counter.name);
+            json << ",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":" << microseconds(counter.time);
+            json << ",\"args\":{\"value\":" << counter.value << "}}";
+        }
+
+        json << "]}";
+        return json.str();
+    }
+
+    void Profiler::SetThreadName(const String& name)
+    {
+        // Threads that never record anything don't get a buffer
+        t_ThreadName = name;
+        if (t_Buffer.buffer)
+        {
+            std::lock_guard<std::mutex> lock(s_BufferLock);
+            t_Buffer.buffer->ThreadName = name;
+        }
+    }
+
+    void Profiler::SetCallTreeWindow(u32 frames)
+    {
+        m_CallTreeWindow = std::max(frames, 1u);
+
+        while (m_CallTreeHistory.size() > m_CallTreeWindow)
+        {
+            for (auto& thread : m_CallTreeHistory.front().children)
+                RemoveCallNode(m_CallTree.children, thread);
+            m_CallTree.calls--;
+
+            m_CallTreeHistory.pop_front();
+        }
+    }
+
+    void Profiler::MergeCallNode(std::vector<ProfilerCallNode>& siblings, const ProfilerCallNode& node)
+    {
+        for (auto& sibling : siblings)
+        {
+            if (sibling.name == node.name)
+            {
+                sibling.inclusive += node.inclusive;
+                sibling.exclusive += node.exclusive;
+                sibling.calls += node.calls;
+                for (auto& child : node.children)
+                    MergeCallNode(sibling.children, child);
+                return;
+            }
+        }
+
+        siblings.push_back(node);
+    }
+
+    void Profiler::RemoveCallNode(std::vector<ProfilerCallNode>& siblings, const ProfilerCallNode& node)
+    {
+        for (auto it = siblings.begin(); it != siblings.end(); ++it)
+        {
+            if (it->name == node.name)
+            {
+                it->inclusive -= node.inclusive;
+                it->exclusive -= node.exclusive;
+                it->calls -= node.calls;
+                for (auto& child : node.children)
+                    RemoveCallNode(it->children, child);
+
+                if (it->calls == 0)
+                    siblings.erase(it);
+                return;
+            }
+        }
+    }
+
+    const char* Profiler::InternThreadName(const String& name)
+    {
+        // Deque elements never move, so the pointers stay valid as call tree names
+        for (auto& threadName : m_ThreadNames)
+            if (threadName == name)
+                return threadName.c_str();
+
+        m_ThreadNames.push_back(name);
+        return m_ThreadNames.back().c_str();
     }
 
     ProfilerReport Profiler::GenerateReport()
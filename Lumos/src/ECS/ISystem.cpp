@@ -0,0 +1,24 @@
+#include "lmpch.h"
+#include "ISystem.h"
+
+namespace Lumos
+{
+	static bool Overlaps(const std::vector<size_t>& lhs, const std::vector<size_t>& rhs)
+	{
+		for (auto type : lhs)
+		{
+			if (std::find(rhs.begin(), rhs.end(), type) != rhs.end())
+				return true;
+		}
+
+		return false;
+	}
+
+	bool ISystem::ConflictsWith(const ISystem& other) const
+	{
+		if (m_Exclusive || other.m_Exclusive)
+			return true;
+
+		return Overlaps(m_Writes, other.m_Writes) || Overlaps(m_Writes, other.m_Reads) || Overlaps(m_Reads, other.m_Writes);
+	}
+}
@@ -18,7 +18,31 @@ namespace Lumos
         
         _FORCE_INLINE_ const String& GetName() const { return m_DebugName; }
 
+		// Component types read / written in OnUpdate, keyed by typeid hash code.
+		// SystemManager runs systems that don't conflict in parallel, an exclusive system runs on its own.
+		const std::vector<size_t>& GetReads() const { return m_Reads; }
+		const std::vector<size_t>& GetWrites() const { return m_Writes; }
+		bool IsExclusive() const { return m_Exclusive; }
+
+		bool ConflictsWith(const ISystem& other) const;
+
     protected:
+		// Declare from the constructor. SystemManager runs the first update of a scene serially,
+		// so pools and groups entt creates lazily exist before systems run in parallel.
+		template<typename T>
+		void Reads() { m_Reads.push_back(typeid(T).hash_code()); m_Exclusive = false; }
+
+		template<typename T>
+		void Writes() { m_Writes.push_back(typeid(T).hash_code()); m_Exclusive = false; }
+
+		// For systems that touch no components at all
+		void SetExclusive(bool exclusive) { m_Exclusive = exclusive; }
+
         String m_DebugName;
+
+	private:
+		std::vector<size_t> m_Reads;
+		std::vector<size_t> m_Writes;
+		bool m_Exclusive = true;
 	};
 }
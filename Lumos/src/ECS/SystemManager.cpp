@@ -0,0 +1,100 @@
+#include "lmpch.h"
+#include "SystemManager.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
+
+namespace Lumos
+{
+	static void UpdateSystem(ISystem* system, TimeStep* dt, Scene* scene)
+	{
+		// Named after the system, so the trace shows which thread ran it and what overlapped
+		LUMOS_PROFILE_BLOCK(system->GetName().c_str());
+		system->OnUpdate(dt, scene);
+	}
+
+	void SystemManager::OnUpdate(TimeStep* dt, Scene* scene)
+	{
+		LUMOS_PROFILE_BLOCK("SystemManager::OnUpdate");
+
+		if (m_ScheduleDirty)
+			BuildSchedule();
+
+		// Pools and groups are created lazily on a scene's first update, that has to happen one system at a time
+		if (scene != m_LastScene)
+		{
+			m_LastScene = scene;
+			for (auto system : m_Ordered)
+				UpdateSystem(system, dt, scene);
+			return;
+		}
+
+		for (u32 stage = 0; stage + 1 < static_cast<u32>(m_StageOffsets.size()); stage++)
+		{
+			LUMOS_PROFILE_BLOCK("SystemManager::Stage");
+
+			const u32 begin = m_StageOffsets[stage];
+			const u32 end = m_StageOffsets[stage + 1];
+
+			// The first system of the stage runs on the calling thread, the others on workers
+			System::JobSystem::Context ctx;
+			for (u32 i = begin + 1; i < end; i++)
+			{
+				ISystem* system = m_Schedule[i];
+				System::JobSystem::Execute(ctx, [system, dt, scene]() { UpdateSystem(system, dt, scene); });
+			}
+
+			UpdateSystem(m_Schedule[begin], dt, scene);
+			System::JobSystem::WaitFor(ctx);
+		}
+	}
+
+	u32 SystemManager::GetStageCount()
+	{
+		if (m_ScheduleDirty)
+			BuildSchedule();
+
+		return static_cast<u32>(m_StageOffsets.size()) - 1;
+	}
+
+	std::vector<ISystem*> SystemManager::GetStage(u32 stage)
+	{
+		if (m_ScheduleDirty)
+			BuildSchedule();
+
+		return std::vector<ISystem*>(m_Schedule.begin() + m_StageOffsets[stage], m_Schedule.begin() + m_StageOffsets[stage + 1]);
+	}
+
+	void SystemManager::BuildSchedule()
+	{
+		// Each system runs one stage after the latest earlier registered system it conflicts with
+		std::vector<u32> stages(m_Ordered.size(), 0);
+		u32 stageCount = 0;
+
+		for (size_t i = 0; i < m_Ordered.size(); i++)
+		{
+			for (size_t j = 0; j < i; j++)
+			{
+				if (m_Ordered[i]->ConflictsWith(*m_Ordered[j]))
+					stages[i] = std::max(stages[i], stages[j] + 1);
+			}
+
+			stageCount = std::max(stageCount, stages[i] + 1);
+		}
+
+		m_Schedule.clear();
+		m_StageOffsets.clear();
+
+		for (u32 stage = 0; stage < stageCount; stage++)
+		{
+			m_StageOffsets.push_back(static_cast<u32>(m_Schedule.size()));
+			for (size_t i = 0; i < m_Ordered.size(); i++)
+			{
+				if (stages[i] == stage)
+					m_Schedule.push_back(m_Ordered[i]);
+			}
+		}
+
+		m_StageOffsets.push_back(static_cast<u32>(m_Schedule.size()));
+		m_ScheduleDirty = false;
+	}
+}
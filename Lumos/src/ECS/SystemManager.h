@@ -17,7 +17,9 @@ namespace Lumos
             
             // Create a pointer to the system and return it so it can be used externally
             Ref<T> system = CreateRef<T>(std::forward<Args>(args) ...);
-            m_Systems.insert({typeName, std::move( system) });
+            m_Systems.insert({typeName, system });
+            m_Ordered.push_back(system.get());
+            m_ScheduleDirty = true;
             return system;
         }
 
@@ -30,7 +32,9 @@ namespace Lumos
 
 			// Create a pointer to the system and return it so it can be used externally
             Ref<T> system = Ref<T>(t);
-            m_Systems.insert({ typeName,std::move( system) });
+            m_Systems.insert({ typeName, system });
+            m_Ordered.push_back(system.get());
+            m_ScheduleDirty = true;
 			return system;
 		}
 
@@ -39,9 +43,12 @@ namespace Lumos
 		{
 			auto typeName = typeid(T).hash_code();
 
-			if (m_Systems.find(typeName) != m_Systems.end())
+			auto it = m_Systems.find(typeName);
+			if (it != m_Systems.end())
 			{
-				m_Systems.erase(typeName);
+				m_Ordered.erase(std::find(m_Ordered.begin(), m_Ordered.end(), it->second.get()));
+				m_Systems.erase(it);
+				m_ScheduleDirty = true;
 			}
 		}
 
@@ -66,20 +73,34 @@ namespace Lumos
 			return m_Systems.find(typeName) != m_Systems.end();
 		}
 
-		void OnUpdate(TimeStep* dt, Scene* scene)
-		{
-			for (auto& system : m_Systems)
-				system.second->OnUpdate(dt, scene);
-		}
+		// Runs the systems stage by stage, systems within a stage in parallel on the JobSystem.
+		// Conflicting systems always run in registration order.
+		void OnUpdate(TimeStep* dt, Scene* scene);
 
 		void OnImGui()
 		{
-			for (auto& system : m_Systems)
-				system.second->OnImGui();
+			for (auto system : m_Ordered)
+				system->OnImGui();
 		}
 
+		u32 GetStageCount();
+		// Systems of a stage in registration order
+		std::vector<ISystem*> GetStage(u32 stage);
+
     private:
+		void BuildSchedule();
+
         // Map from system type string pointer to a system pointer
         std::unordered_map<size_t, Ref<ISystem>> m_Systems;
+
+		// Systems in registration order
+		std::vector<ISystem*> m_Ordered;
+
+		// Systems sorted by stage, with the first system of each stage and the system count as the last entry
+		std::vector<ISystem*> m_Schedule;
+		std::vector<u32> m_StageOffsets;
+		bool m_ScheduleDirty = true;
+
+		Scene* m_LastScene = nullptr;
     };
 }
@@ -9,6 +9,7 @@
 #include "Graphics/Layers/LayerStack.h"
 #include "Graphics/RenderManager.h"
 #include "Graphics/GBuffer.h"
+#include "Core/OS/MemoryManager.h"
 #include "ImGui/ImGuiHelpers.h"
 #include <imgui/imgui.h>
 
@@ -46,6 +47,12 @@ namespace Lumos
 				ImGui::Text("FPS : %5.2i", Engine::Instance()->GetFPS());
 				ImGui::Text("UPS : %5.2i", Engine::Instance()->GetUPS());
 				ImGui::Text("Frame Time : %5.2f ms", Engine::Instance()->GetFrametime());
+
+				const FrameTimeHistory& frameTimes = Engine::Instance()->GetFrameTimes();
+				const FrameTimeStats stats = frameTimes.CalculateStats();
+				ImGui::Text("Last %u frames : p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms", stats.frames, stats.p50, stats.p95, stats.p99, stats.max);
+				ImGui::PlotLines("##FrameTimes", [](void* data, int index) { return static_cast<const FrameTimeHistory*>(data)->Get(static_cast<u32>(index)); },
+					const_cast<FrameTimeHistory*>(&frameTimes), static_cast<int>(frameTimes.GetCount()), 0, nullptr, 0.0f, stats.max, ImVec2(0.0f, 60.0f));
 				ImGui::NewLine();
 				ImGui::Text("Scene : %s", Application::Instance()->GetSceneManager()->GetCurrentScene()->GetSceneName().c_str());
 
@@ -82,6 +89,49 @@ namespace Lumos
 					}
 					ImGui::TreePop();
 				}
+
+				if (ImGui::TreeNode("Memory"))
+				{
+					ImGui::Columns(5);
+					ImGui::Text("Tag");
+					ImGui::NextColumn();
+					ImGui::Text("Current");
+					ImGui::NextColumn();
+					ImGui::Text("Peak");
+					ImGui::NextColumn();
+					ImGui::Text("Budget");
+					ImGui::NextColumn();
+					ImGui::Text("Allocs / Frame");
+					ImGui::NextColumn();
+					ImGui::Separator();
+
+					for (int i = 0; i < static_cast<int>(MemoryTag::Count); ++i)
+					{
+						const MemoryTag tag = static_cast<MemoryTag>(i);
+						const MemoryTagStats stats = MemoryManager::GetTagStats(tag);
+
+						if (stats.overBudget)
+							ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", MemoryManager::GetTagName(tag));
+						else
+							ImGui::Text("%s", MemoryManager::GetTagName(tag));
+						ImGui::NextColumn();
+						ImGui::Text("%s", MemoryManager::BytesToString(stats.currentUsed).c_str());
+						ImGui::NextColumn();
+						ImGui::Text("%s", MemoryManager::BytesToString(stats.peakUsed).c_str());
+						ImGui::NextColumn();
+						ImGui::Text("%s", stats.budget > 0 ? MemoryManager::BytesToString(stats.budget).c_str() : "-");
+						ImGui::NextColumn();
+						ImGui::Text("%lld (%s)", static_cast<long long>(stats.frameAllocations), MemoryManager::BytesToString(stats.frameAllocated).c_str());
+						ImGui::NextColumn();
+					}
+					ImGui::Columns(1);
+
+					const MemoryStats memoryStats = MemoryManager::Get()->GetMemoryStats();
+					ImGui::NewLine();
+					ImGui::Text("Frame Allocator : %s (peak %s)", MemoryManager::BytesToString(memoryStats.frameAllocated).c_str(), MemoryManager::BytesToString(memoryStats.peakFrameAllocated).c_str());
+
+					ImGui::TreePop();
+				}
 				ImGui::TreePop();
 			};
 		}
@@ -18,6 +18,7 @@
 #include "Events/ApplicationEvent.h"
 
 #include "ECS/Component/Components.h"
+#include "Maths/TransformStore.h"
 #include "Physics/LumosPhysicsEngine/LumosPhysicsEngine.h"
 #include "Graphics/Layers/Layer3D.h"
 
@@ -64,6 +65,8 @@ namespace Lumos
 
 	void Editor::OnInit()
 	{
+		LUMOS_MEMORY_TAG(Editor);
+
 		const char *ini[] = { "editor.ini", "editor/editor.ini", "../editor/editor.ini" };
 		bool fileFound = false;
 		for (int i = 0; i < IM_ARRAYSIZE(ini); ++i) 
@@ -92,6 +95,7 @@ namespace Lumos
 		m_ComponentIconMap[typeid(SoundComponent).hash_code()] = ICON_FA_VOLUME_UP;
 		m_ComponentIconMap[typeid(Graphics::Sprite).hash_code()] = ICON_FA_IMAGE;
 		m_ComponentIconMap[typeid(Maths::Transform).hash_code()] = ICON_FA_VECTOR_SQUARE;
+		m_ComponentIconMap[typeid(Maths::SoATransform).hash_code()] = ICON_FA_VECTOR_SQUARE;
 		m_ComponentIconMap[typeid(Physics2DComponent).hash_code()] = ICON_FA_SQUARE;
 		m_ComponentIconMap[typeid(Physics3DComponent).hash_code()] = ICON_FA_CUBE;
 		m_ComponentIconMap[typeid(MeshComponent).hash_code()] = ICON_FA_SHAPES;
@@ -127,6 +131,7 @@ namespace Lumos
 	void Editor::OnImGui()
 	{
 		LUMOS_PROFILE_FUNC;
+		LUMOS_MEMORY_TAG(Editor);
 		DrawMenuBar();
 
 		BeginDockSpace(false);
@@ -1,6 +1,7 @@
 #include "lmpch.h"
 #include "GraphicsInfoWindow.h"
 #include "Graphics/API/GraphicsContext.h"
+#include "Graphics/API/Renderer.h"
 
 #include <imgui/imgui.h>
 
@@ -18,6 +19,26 @@ namespace Lumos
 		ImGui::Begin("GraphicsInfo", &m_Active, flags);
 		{
 			Graphics::GraphicsContext::GetContext()->OnImGui();
+
+			ImGui::Separator();
+
+			auto& stats = Graphics::Renderer::GetRenderStats();
+			auto stat = [](const char* name, unsigned long long value)
+			{
+				ImGui::TextUnformatted(name);
+				ImGui::NextColumn();
+				ImGui::Text("%llu", value);
+				ImGui::NextColumn();
+			};
+
+			ImGui::Columns(2);
+			stat("Draw Calls", stats.drawCalls);
+			stat("Triangles", stats.triangles);
+			stat("Visible Objects", stats.visibleObjects);
+			stat("Culled Objects", stats.culledObjects);
+			stat("Descriptor Binds", stats.descriptorSetBinds);
+			stat("Uniform Bytes Uploaded", stats.uniformBytesUploaded);
+			ImGui::Columns(1);
 		}
 		ImGui::End();
 	}
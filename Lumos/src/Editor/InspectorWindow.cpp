@@ -8,6 +8,7 @@
 #include "Graphics/Sprite.h"
 #include "Graphics/Light.h"
 #include "Maths/Transform.h"
+#include "Maths/TransformStore.h"
 
 #include <imgui/imgui.h>
 #include <IconFontCppHeaders/IconsFontAwesome5.h>
@@ -376,6 +377,11 @@ namespace Lumos
 		material.OnImGui();
 	}
 
+	static void SoATransformWidget(Maths::SoATransform& transform)
+	{
+		transform.OnImGui();
+	}
+
 	InspectorWindow::InspectorWindow()
 	{
 		m_Name = ICON_FA_INFO_CIRCLE" Inspector###inspector";
@@ -402,6 +408,7 @@ namespace Lumos
 						func(comp); });
 
 		TRIVIAL_COMPONENT(Maths::Transform, "Transform", TransformWidget);
+		TRIVIAL_COMPONENT(Maths::SoATransform, "SoA Transform", SoATransformWidget);
 		TRIVIAL_COMPONENT(MeshComponent, "Mesh", MeshWidget);
 		TRIVIAL_COMPONENT(CameraComponent, "Camera", CameraWidget);
 		TRIVIAL_COMPONENT(Physics3DComponent, "Physics3D", Physics3DWidget);
@@ -51,6 +51,7 @@ namespace Lumos
 		useColoredLegendText = true;
 		fpsFramesCount = 0;
 		avgFrameTime = 1.0f;
+		captureFrameCount = 60;
 
 		Profiler::Instance()->Enable();
 
@@ -86,6 +87,35 @@ namespace Lumos
 			ImGui::SliderFloat("Transparency", &ImGui::GetStyle().Colors[ImGuiCol_WindowBg].w, 0.0f, 1.0f);
 			ImGui::Columns(1);
 		}
+
+		if (profiler->IsCapturing())
+		{
+			ImGui::Text("Capturing, %u frames left", profiler->GetCaptureFramesLeft());
+		}
+		else
+		{
+			ImGui::PushItemWidth(100.0f);
+			ImGui::DragInt("##CaptureFrames", &captureFrameCount, 1.0f, 1, 1000);
+			ImGui::PopItemWidth();
+			ImGui::SameLine();
+			if (ImGui::Button("Capture Trace"))
+				profiler->CaptureFrames(static_cast<u32>(captureFrameCount));
+			if (!profiler->GetCapturePath().empty())
+			{
+				ImGui::SameLine();
+				ImGui::Text("Last capture : %s", profiler->GetCapturePath().c_str());
+			}
+		}
+
+		if (ImGui::CollapsingHeader("Flame Graph"))
+			DrawFlameGraph();
+
+		if (ImGui::CollapsingHeader("Frame Spikes"))
+			DrawSpikes();
+
+		if (ImGui::CollapsingHeader("Counters"))
+			DrawCounters();
+
 		if (!profiler->IsEnabled())
 			frameOffset = 0;
 		m_CPUGraph.frameWidth = frameWidth;
@@ -96,6 +126,131 @@ namespace Lumos
 
 	}
 
+	void ProfilerWindow::DrawSpikes()
+	{
+		auto profiler = Profiler::Instance();
+
+		float threshold = profiler->GetSpikeThreshold();
+		if (ImGui::DragFloat("Spike threshold (ms)", &threshold, 0.5f, 0.0f, 1000.0f, threshold > 0.0f ? "%.1f" : "Off"))
+			profiler->SetSpikeThreshold(threshold);
+
+		const auto& spikes = profiler->GetSpikes();
+		if (spikes.empty())
+			return;
+
+		ImGui::SameLine();
+		if (ImGui::Button("Clear"))
+		{
+			profiler->ClearSpikes();
+			return;
+		}
+
+		for (u32 i = 0; i < spikes.size(); ++i)
+		{
+			ImGui::PushID(static_cast<int>(i));
+			ImGui::Text("Frame %llu : %.2f ms, %u events", static_cast<unsigned long long>(spikes[i].frame), spikes[i].frameTime, static_cast<u32>(spikes[i].trace.events.size()));
+			ImGui::SameLine();
+			if (ImGui::Button("Save Trace"))
+			{
+				const String path = "profiler_spike_" + std::to_string(spikes[i].frame) + ".json";
+				if (profiler->SaveSpike(i, path))
+					Debug::Log::Info("Saved frame spike to {0}", path);
+			}
+			ImGui::PopID();
+		}
+	}
+
+	void ProfilerWindow::DrawCounters()
+	{
+		const auto& counters = Profiler::Instance()->GetCounters();
+		if (counters.empty())
+		{
+			ImGui::TextUnformatted("No counters set");
+			return;
+		}
+
+		ImGui::Columns(2);
+		for (auto& counter : counters)
+		{
+			ImGui::TextUnformatted(counter.name);
+			ImGui::NextColumn();
+			ImGui::Text("%.0f", counter.value);
+			ImGui::NextColumn();
+		}
+		ImGui::Columns(1);
+	}
+
+	static const float FlameRowHeight = 18.0f;
+
+	void ProfilerWindow::DrawFlameGraph()
+	{
+		auto profiler = Profiler::Instance();
+		const ProfilerCallNode& tree = profiler->GetCallTree();
+		const u32 frames = profiler->GetCallTreeFrameCount();
+
+		int window = static_cast<int>(profiler->GetCallTreeWindow());
+		if (ImGui::SliderInt("Averaged frames", &window, 1, 300))
+			profiler->SetCallTreeWindow(static_cast<u32>(window));
+
+		double maxTime = 0.0;
+		for (auto& thread : tree.children)
+			maxTime = std::max(maxTime, thread.inclusive);
+
+		if (frames == 0 || maxTime <= 0.0)
+			return;
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		const float width = ImGui::GetContentRegionAvail().x;
+		const float scale = static_cast<float>(width / maxTime);
+
+		Maths::Vector2 pos = Maths::Vector2(ImGui::GetCursorScreenPos().x, ImGui::GetCursorScreenPos().y);
+		const float top = pos.y;
+		for (auto& thread : tree.children)
+		{
+			if (thread.children.empty())
+				continue;
+
+			const u32 depth = DrawFlameNode(drawList, thread, pos, scale, frames);
+			pos.y += (depth + 1) * FlameRowHeight + FlameRowHeight * 0.5f;
+		}
+
+		ImGui::Dummy(ImVec2(width, pos.y - top));
+	}
+
+	u32 ProfilerWindow::DrawFlameNode(ImDrawList* drawList, const ProfilerCallNode& node, const Maths::Vector2& pos, float scale, u32 frames)
+	{
+		const float width = static_cast<float>(node.inclusive) * scale;
+		if (width < 1.0f)
+			return 0;
+
+		const Maths::Vector2 max = pos + Maths::Vector2(width - 1.0f, FlameRowHeight - 1.0f);
+		ProfilerGraph::Rect(drawList, pos, max, m_CPUGraph.Columnour(node.name), true);
+
+		drawList->PushClipRect(ImVec2(pos.x, pos.y), ImVec2(max.x, max.y), true);
+		ProfilerGraph::Text(drawList, pos + Maths::Vector2(3.0f, 2.0f), IM_COL32(0, 0, 0, 255), node.name);
+		drawList->PopClipRect();
+
+		if (ImGui::IsMouseHoveringRect(ImVec2(pos.x, pos.y), ImVec2(max.x, max.y)))
+		{
+			ImGui::BeginTooltip();
+			ImGui::Text("%s", node.name);
+			ImGui::Text("Inclusive : %.3f ms", node.inclusive / frames);
+			ImGui::Text("Exclusive : %.3f ms", node.exclusive / frames);
+			ImGui::Text("Calls per frame : %.1f", static_cast<double>(node.calls) / frames);
+			ImGui::EndTooltip();
+		}
+
+		// Children are laid out left to right under their parent, in order of first appearance
+		u32 depth = 0;
+		Maths::Vector2 childPos = pos + Maths::Vector2(0.0f, FlameRowHeight);
+		for (auto& child : node.children)
+		{
+			depth = std::max(depth, DrawFlameNode(drawList, child, childPos, scale, frames) + 1);
+			childPos.x += static_cast<float>(child.inclusive) * scale;
+		}
+		return depth;
+	}
+
 	ProfilerGraph::ProfilerGraph(): frameWidth(0), frameSpacing(0), useColoredLegendText(false)
 	{
 		m_Reports.reserve(300);
@@ -55,6 +55,16 @@ namespace Lumos
 
 		void OnImGui() override;
 	private:
+		// Call tree averaged over the profiler's window of frames, one block per thread
+		void DrawFlameGraph();
+		u32 DrawFlameNode(ImDrawList* drawList, const ProfilerCallNode& node, const Maths::Vector2& pos, float scale, u32 frames);
+
+		// Frames kept by the profiler's spike threshold, each can be saved as a Chrome trace
+		void DrawSpikes();
+
+		// Latest value of every counter set with Profiler::SetCounter
+		void DrawCounters();
+
 		float m_UpdateFrequency;
 		float m_UpdateTimer;
 
@@ -69,5 +79,6 @@ namespace Lumos
 		//TimePoint prevFpsFrameTime;
 		size_t fpsFramesCount;
 		float avgFrameTime;
+		int captureFrameCount;
 	};
 }
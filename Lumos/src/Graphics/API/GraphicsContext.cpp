@@ -13,6 +13,9 @@
 #include "Graphics/DirectX/DXContext.h"
 #include "Graphics/DirectX/DXFunctions.h"
 #endif
+#ifdef LUMOS_RENDER_API_NONE
+#include "Platform/Null/NullFunctions.h"
+#endif
 
 namespace Lumos
 {
@@ -61,6 +64,11 @@ namespace Lumos
 			case RenderAPI::DIRECT3D:
 				Graphics::DIRECT3D::MakeDefault();
 				break;
+#endif
+#ifdef LUMOS_RENDER_API_NONE
+			case RenderAPI::NONE:
+				Graphics::Null::MakeDefault();
+				break;
 #endif
 			}
 		}
@@ -21,12 +21,12 @@ namespace Lumos
 			DIRECT3D, //Unsupported
 		#endif
 
-		#ifdef LUMOS_RENDER_API_NONE
+		#ifdef LUMOS_RENDER_API_METAL
 			METAL, //Unsupported
 		#endif
 
 		#ifdef LUMOS_RENDER_API_NONE
-			NONE, //Unsupported
+			NONE, //Records draws and uploads without a GPU
 		#endif
 		};
 
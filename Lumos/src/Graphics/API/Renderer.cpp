@@ -15,6 +15,7 @@
 #include "GraphicsContext.h"
 
 #include "../Camera/Camera.h"
+#include "Core/Profiler.h"
 
 namespace Lumos
 {
@@ -24,6 +25,9 @@ namespace Lumos
 
 		Renderer* Renderer::s_Instance = nullptr;
 
+		RenderStats Renderer::s_FrameStats;
+		RenderStats Renderer::s_LastFrameStats;
+
 		void Renderer::Init(u32 width, u32 height)
 		{
             LUMOS_ASSERT(CreateFunc, "No Renderer Create Function");
@@ -38,5 +42,25 @@ namespace Lumos
 
 			s_Instance = nullptr;
 		}
+
+		void Renderer::ResetRenderStats()
+		{
+			s_FrameStats = RenderStats();
+			s_LastFrameStats = RenderStats();
+		}
+
+		void Renderer::EndRenderStatsFrame()
+		{
+			s_LastFrameStats = s_FrameStats;
+			s_FrameStats = RenderStats();
+
+			auto profiler = Profiler::Instance();
+			profiler->SetCounter("Render Draw Calls", s_LastFrameStats.drawCalls);
+			profiler->SetCounter("Render Triangles", static_cast<double>(s_LastFrameStats.triangles));
+			profiler->SetCounter("Render Visible Objects", s_LastFrameStats.visibleObjects);
+			profiler->SetCounter("Render Culled Objects", s_LastFrameStats.culledObjects);
+			profiler->SetCounter("Render Descriptor Binds", s_LastFrameStats.descriptorSetBinds);
+			profiler->SetCounter("Render Uniform Bytes", static_cast<double>(s_LastFrameStats.uniformBytesUploaded));
+		}
 	}
 }
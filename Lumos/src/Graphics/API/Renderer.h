@@ -75,6 +75,19 @@ namespace Lumos
 			UNSIGNED_BYTE
 		};
 
+		// Counters for one frame, filled by the draw and bind calls below, UniformBuffer::SetData and the renderers' culling.
+		// Independent of the graphics API.
+		struct RenderStats
+		{
+			u32 drawCalls = 0;
+			u64 indices = 0;
+			u64 triangles = 0;
+			u32 visibleObjects = 0;
+			u32 culledObjects = 0;
+			u32 descriptorSetBinds = 0;
+			u64 uniformBytesUploaded = 0;
+		};
+
 		class LUMOS_EXPORT Renderer
 		{
 		public:
@@ -97,19 +110,41 @@ namespace Lumos
 			virtual void DrawInternal(CommandBuffer* commandBuffer, DrawType type, u32 count, DataType datayType, void* indices) const = 0;
 			virtual Graphics::Swapchain* GetSwapchainInternal() const = 0;
 
-			_FORCE_INLINE_ static void Present() { s_Instance->PresentInternal(); }
+			_FORCE_INLINE_ static void Present() { s_Instance->PresentInternal(); EndRenderStatsFrame(); }
 			_FORCE_INLINE_ static void Present(Graphics::CommandBuffer* cmdBuffer) { s_Instance->PresentInternal(cmdBuffer); }
-			_FORCE_INLINE_ static void BindDescriptorSets(Graphics::Pipeline* pipeline, Graphics::CommandBuffer* cmdBuffer, u32 dynamicOffset, std::vector<Graphics::DescriptorSet*>& descriptorSets) { s_Instance->BindDescriptorSetsInternal(pipeline, cmdBuffer, dynamicOffset, descriptorSets); }
-			_FORCE_INLINE_ static void Draw(CommandBuffer* commandBuffer, DrawType type, u32 count, DataType datayType = DataType::UNSIGNED_INT, void* indices = nullptr) { s_Instance->DrawInternal(commandBuffer, type, count, datayType, indices); }
-			_FORCE_INLINE_ static void DrawIndexed(CommandBuffer* commandBuffer, DrawType type, u32 count, u32 start = 0) { s_Instance->DrawIndexedInternal(commandBuffer, type, count, start); }
+			_FORCE_INLINE_ static void BindDescriptorSets(Graphics::Pipeline* pipeline, Graphics::CommandBuffer* cmdBuffer, u32 dynamicOffset, std::vector<Graphics::DescriptorSet*>& descriptorSets) { s_FrameStats.descriptorSetBinds += static_cast<u32>(descriptorSets.size()); s_Instance->BindDescriptorSetsInternal(pipeline, cmdBuffer, dynamicOffset, descriptorSets); }
+			_FORCE_INLINE_ static void Draw(CommandBuffer* commandBuffer, DrawType type, u32 count, DataType datayType = DataType::UNSIGNED_INT, void* indices = nullptr) { RecordDraw(type, count); s_Instance->DrawInternal(commandBuffer, type, count, datayType, indices); }
+			_FORCE_INLINE_ static void DrawIndexed(CommandBuffer* commandBuffer, DrawType type, u32 count, u32 start = 0) { RecordDraw(type, count); s_Instance->DrawIndexedInternal(commandBuffer, type, count, start); }
 			_FORCE_INLINE_ static const String& GetTitle() { return s_Instance->GetTitleInternal(); }
 
 			_FORCE_INLINE_ static Swapchain* GetSwapchain() { return s_Instance->GetSwapchainInternal(); }
-            
+
+			// Stats of the last presented frame, and of the frame still being recorded
+			static const RenderStats& GetRenderStats() { return s_LastFrameStats; }
+			static const RenderStats& GetCurrentRenderStats() { return s_FrameStats; }
+			static void ResetRenderStats();
+
+			_FORCE_INLINE_ static void RecordCulling(bool visible) { visible ? s_FrameStats.visibleObjects++ : s_FrameStats.culledObjects++; }
+			_FORCE_INLINE_ static void RecordUniformUpload(u32 bytes) { s_FrameStats.uniformBytesUploaded += bytes; }
+
         protected:
             static Renderer* (*CreateFunc)(u32, u32);
             
             static Renderer* s_Instance;
+
+			_FORCE_INLINE_ static void RecordDraw(DrawType type, u32 count)
+			{
+				s_FrameStats.drawCalls++;
+				s_FrameStats.indices += count;
+				if (type == DrawType::TRIANGLE)
+					s_FrameStats.triangles += count / 3;
+			}
+
+			// Rolls the stats over and hands them to the profiler as counters
+			static void EndRenderStatsFrame();
+
+			static RenderStats s_FrameStats;
+			static RenderStats s_LastFrameStats;
 		};
 	}
 }
@@ -2,6 +2,7 @@
 #include "UniformBuffer.h"
 
 #include "GraphicsContext.h"
+#include "Renderer.h"
 
 #ifdef LUMOS_RENDER_API_VULKAN 
 #include "Platform/Vulkan/VKUniformBuffer.h"
@@ -31,5 +32,17 @@ namespace Lumos
             
             return CreateDataFunc(size, data);
 		}
+
+		void UniformBuffer::SetData(uint32_t size, const void* data)
+		{
+			Renderer::RecordUniformUpload(size);
+			SetDataInternal(size, data);
+		}
+
+		void UniformBuffer::SetDynamicData(uint32_t size, uint32_t typeSize, const void* data)
+		{
+			Renderer::RecordUniformUpload(size);
+			SetDynamicDataInternal(size, typeSize, data);
+		}
 	}
 }
@@ -12,8 +12,10 @@ namespace Lumos
 			static UniformBuffer* Create(uint32_t size, const void* data);
 
 			virtual void Init(uint32_t size, const void* data) = 0;
-			virtual void SetData(uint32_t size, const void* data) = 0;
-			virtual void SetDynamicData(uint32_t size, uint32_t typeSize, const void* data) = 0;
+
+			// Counted in the renderer's frame stats before being handed to the backend
+			void SetData(uint32_t size, const void* data);
+			void SetDynamicData(uint32_t size, uint32_t typeSize, const void* data);
 
 			virtual u8* GetBuffer() const = 0;
             
@@ -21,6 +23,9 @@ namespace Lumos
             static UniformBuffer* (*CreateFunc)();
             static UniformBuffer* (*CreateDataFunc)(uint32_t, const void*);
 
+			virtual void SetDataInternal(uint32_t size, const void* data) = 0;
+			virtual void SetDynamicDataInternal(uint32_t size, uint32_t typeSize, const void* data) = 0;
+
 
 		};
 	}
@@ -6,6 +6,8 @@ namespace Lumos
 {
 	entt::entity ModelLoader::LoadModel(const String& path, entt::registry& registry)
 	{
+		LUMOS_MEMORY_TAG(Assets);
+
 		std::string physicalPath;
 		if (!Lumos::VFS::Get()->ResolvePhysicalPath(path, physicalPath))
 		{
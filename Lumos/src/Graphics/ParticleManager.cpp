@@ -7,6 +7,7 @@
 #include "API/Renderer.h"
 #include "Mesh.h"
 #include "MeshFactory.h"
+#include "Core/Profiler.h"
 
 namespace Lumos
 {
@@ -30,6 +31,7 @@ namespace Lumos
 
 	void ParticleManager::Update(float dt)
 	{
+		LUMOS_PROFILE_BLOCK("ParticleManager::Update");
 		for (auto emitter : m_Emitters)
 		{
 			emitter->Update(dt);
@@ -8,6 +8,7 @@
 
 #include "Maths/Maths.h"
 #include "Maths/Transform.h"
+#include "Maths/TransformStore.h"
 #include "Core/Profiler.h"
 
 #include "Graphics/RenderManager.h"
@@ -159,42 +160,71 @@ namespace Lumos
             
             auto group = registry.group<MeshComponent>(entt::get<Maths::Transform>);
 
+            m_CullEntities.clear();
+            m_CullWorldMatrices.clear();
+            m_CullBounds.Clear();
+
             for(auto entity : group)
             {
                 const auto &[mesh, trans] = group.get<MeshComponent, Maths::Transform>(entity);
 
                 if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
                 {
-                    auto& worldTransform = trans.GetWorldMatrix();
-
-					auto bb = mesh.GetMesh()->GetBoundingBox();
-                    auto bbCopy = bb->Transformed(worldTransform);
-					auto inside = m_Frustum.IsInsideFast(bbCopy);
-
-                    if (inside == Maths::Intersection::OUTSIDE)
-						continue;
-
-                    auto meshPtr = mesh.GetMesh();
-                    auto materialComponent = registry.try_get<MaterialComponent>(entity);
-                    Material* material = nullptr;
-                    if (materialComponent && materialComponent->GetActive() && materialComponent->GetMaterial())
-                    {
-                        material = materialComponent->GetMaterial().get();
-
-                        if (material->GetDescriptorSet() == nullptr || material->GetPipeline() != m_Pipeline)
-                            material->CreateDescriptorSet(m_Pipeline, 1);
-                    }
-
-                    auto textureMatrixTransform = registry.try_get<TextureMatrixComponent>(entity);
-                    Maths::Matrix4 textureMatrix;
-                    if (textureMatrixTransform)
-                        textureMatrix = textureMatrixTransform->GetMatrix();
-                    else
-                        textureMatrix = Maths::Matrix4();
-
-                    SubmitMesh(meshPtr, material, worldTransform, textureMatrix);
+                    m_CullBounds.Add(mesh.GetMesh()->GetBoundingBox()->Transformed(trans.GetWorldMatrix()));
+                    m_CullEntities.push_back(entity);
+                    m_CullWorldMatrices.push_back(&trans.GetWorldMatrix());
                 }
-			}
+            }
+
+            // SoA transforms only read their world matrix array
+            auto bulkGroup = registry.group(entt::get<MeshComponent, Maths::SoATransform>, entt::exclude<Maths::Transform>);
+            for(auto entity : bulkGroup)
+            {
+                const auto &[mesh, trans] = bulkGroup.get<MeshComponent, Maths::SoATransform>(entity);
+
+                if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
+                {
+                    m_CullBounds.Add(mesh.GetMesh()->GetBoundingBox()->Transformed(trans.GetWorldMatrix()));
+                    m_CullEntities.push_back(entity);
+                    m_CullWorldMatrices.push_back(&trans.GetWorldMatrix());
+                }
+            }
+
+            m_CullVisibility.resize(Maths::GetVisibilityWordCount(m_CullBounds.Size()));
+            Maths::CullBoxes(&m_Frustum, 1, m_CullBounds, m_CullVisibility.data());
+
+            for (u32 i = 0; i < m_CullEntities.size(); i++)
+            {
+                const bool visible = Maths::IsBoxVisible(m_CullVisibility.data(), i);
+                Renderer::RecordCulling(visible);
+
+                if (!visible)
+                    continue;
+
+                auto entity = m_CullEntities[i];
+                auto& mesh = registry.get<MeshComponent>(entity);
+                auto& worldTransform = *m_CullWorldMatrices[i];
+
+                auto meshPtr = mesh.GetMesh();
+                auto materialComponent = registry.try_get<MaterialComponent>(entity);
+                Material* material = nullptr;
+                if (materialComponent && materialComponent->GetActive() && materialComponent->GetMaterial())
+                {
+                    material = materialComponent->GetMaterial().get();
+
+                    if (material->GetDescriptorSet() == nullptr || material->GetPipeline() != m_Pipeline)
+                        material->CreateDescriptorSet(m_Pipeline, 1);
+                }
+
+                auto textureMatrixTransform = registry.try_get<TextureMatrixComponent>(entity);
+                Maths::Matrix4 textureMatrix;
+                if (textureMatrixTransform)
+                    textureMatrix = textureMatrixTransform->GetMatrix();
+                else
+                    textureMatrix = Maths::Matrix4();
+
+                SubmitMesh(meshPtr, material, worldTransform, textureMatrix);
+            }
 
 			SetSystemUniforms(m_Shader);
 
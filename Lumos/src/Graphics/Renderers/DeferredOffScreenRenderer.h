@@ -2,6 +2,8 @@
 #include "Renderer3D.h"
 #include "Maths/Frustum.h"
 
+#include <entt/entt.hpp>
+
 namespace Lumos
 {
 	class LightSetup;
@@ -73,6 +75,12 @@ namespace Lumos
 
 			Maths::Frustum m_Frustum;
 
+			// Reused every frame for batch culling
+			std::vector<entt::entity> m_CullEntities;
+			std::vector<const Maths::Matrix4*> m_CullWorldMatrices;
+			Maths::BoundingBoxList m_CullBounds;
+			std::vector<u32> m_CullVisibility;
+
 			struct UniformBufferModel
 			{
 				Maths::Matrix4* model;
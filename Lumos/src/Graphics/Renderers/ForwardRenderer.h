@@ -3,6 +3,8 @@
 #include "Renderer3D.h"
 #include "Maths/Frustum.h"
 
+#include <entt/entt.hpp>
+
 namespace Lumos
 {
 	class LightSetup;
@@ -72,6 +74,12 @@ namespace Lumos
 
 			Maths::Frustum m_Frustum;
 
+			// Reused every frame for batch culling
+			std::vector<entt::entity> m_CullEntities;
+			std::vector<const Maths::Matrix4*> m_CullWorldMatrices;
+			Maths::BoundingBoxList m_CullBounds;
+			std::vector<u32> m_CullVisibility;
+
 			u32 m_CurrentBufferID = 0;
 
 		};
@@ -322,6 +322,7 @@ namespace Lumos
 				auto bb = Maths::BoundingBox(Maths::Rect(sprite.GetPosition(), sprite.GetPosition() + sprite.GetScale()));
 				bb.Transform(trans.GetWorldMatrix());
                 auto inside = m_Frustum.IsInside(bb);
+                Renderer::RecordCulling(inside != Maths::Intersection::OUTSIDE);
                 
 				if (inside == Maths::Intersection::OUTSIDE)
 					continue;
@@ -18,6 +18,7 @@
 #include "ECS/Component/MeshComponent.h"
 
 #include "Maths/Transform.h"
+#include "Maths/TransformStore.h"
 
 #include "App/Scene.h"
 #include "Maths/Maths.h"
@@ -162,14 +163,15 @@ namespace Lumos
 
 			m_Pipeline->SetActive(m_CommandBuffer);
 
+			// Same set for every command
+			std::vector<Graphics::DescriptorSet*> descriptorSets = { m_Pipeline->GetDescriptorSet() };
+
 			for (auto& command : m_CommandQueue)
 			{
 				Mesh* mesh = command.mesh;
 
 				const uint32_t dynamicOffset = index * static_cast<uint32_t>(dynamicAlignment);
 
-				std::vector<Graphics::DescriptorSet*> descriptorSets = { m_Pipeline->GetDescriptorSet() };
-
 				mesh->GetVertexArray()->Bind(m_CommandBuffer);
 				mesh->GetIndexBuffer()->Bind(m_CommandBuffer);
 
@@ -213,39 +215,71 @@ namespace Lumos
             auto& registry = scene->GetRegistry();
                                     
             auto group = registry.group<MeshComponent>(entt::get<Maths::Transform>);
-            
-			for (u32 i = 0; i < m_ShadowMapNum; ++i)
+
+			// Reused by every cascade, only the layer changes
+			std::vector<Graphics::PushConstant> pcVector = { *m_PushConstant };
+
+			// World bounds are computed once and tested against every cascade together
+			m_CullEntities.clear();
+			m_CullWorldMatrices.clear();
+			m_CullBounds.Clear();
+
+			for (auto entity : group)
 			{
-				m_Layer = i;
+				const auto &[mesh, trans] = group.get<MeshComponent, Maths::Transform>(entity);
 
-				Maths::Frustum f;
-				f.Define(m_ShadowProjView[i]);
+				if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
+				{
+					m_CullBounds.Add(mesh.GetMesh()->GetBoundingBox()->Transformed(trans.GetWorldMatrix()));
+					m_CullEntities.push_back(entity);
+					m_CullWorldMatrices.push_back(&trans.GetWorldMatrix());
+				}
+			}
 
-                for(auto entity : group)
-                {
-                    const auto &[mesh, trans] = group.get<MeshComponent, Maths::Transform>(entity);
+			// SoA transforms only read their world matrix array
+			auto bulkGroup = registry.group(entt::get<MeshComponent, Maths::SoATransform>, entt::exclude<Maths::Transform>);
+			for (auto entity : bulkGroup)
+			{
+				const auto &[mesh, trans] = bulkGroup.get<MeshComponent, Maths::SoATransform>(entity);
 
-                    if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
-                    {
-                        auto& worldTransform = trans.GetWorldMatrix();
+				if (mesh.GetMesh() && mesh.GetMesh()->GetActive())
+				{
+					m_CullBounds.Add(mesh.GetMesh()->GetBoundingBox()->Transformed(trans.GetWorldMatrix()));
+					m_CullEntities.push_back(entity);
+					m_CullWorldMatrices.push_back(&trans.GetWorldMatrix());
+				}
+			}
 
-						auto bb = mesh.GetMesh()->GetBoundingBox();
-						auto bbCopy = bb->Transformed(worldTransform);
-						auto inside = f.IsInsideFast(bbCopy);
+			Maths::Frustum cascadeFrustums[SHADOWMAP_MAX];
+			for (u32 i = 0; i < m_ShadowMapNum; ++i)
+				cascadeFrustums[i].Define(m_ShadowProjView[i]);
 
-						if (inside == Maths::Intersection::OUTSIDE)
-							continue;
+			const u32 visibilityWords = Maths::GetVisibilityWordCount(m_CullBounds.Size());
+			m_CullVisibility.resize(visibilityWords * m_ShadowMapNum);
+			Maths::CullBoxes(cascadeFrustums, m_ShadowMapNum, m_CullBounds, m_CullVisibility.data());
             
-                        SubmitMesh(mesh.GetMesh(), nullptr, worldTransform, Maths::Matrix4());
-					}
-                }
+			for (u32 i = 0; i < m_ShadowMapNum; ++i)
+			{
+				m_Layer = i;
+
+				const u32* visibility = m_CullVisibility.data() + i * visibilityWords;
+				for (u32 j = 0; j < m_CullEntities.size(); j++)
+				{
+					const bool visible = Maths::IsBoxVisible(visibility, j);
+					Renderer::RecordCulling(visible);
+
+					if (!visible)
+						continue;
+
+					auto& mesh = registry.get<MeshComponent>(m_CullEntities[j]);
+					SubmitMesh(mesh.GetMesh(), nullptr, *m_CullWorldMatrices[j], Maths::Matrix4());
+				}
 
 				SetSystemUniforms(m_Shader);
 
 				i32 layer = static_cast<i32>(m_Layer);
 				memcpy(m_PushConstant->data, &layer, sizeof(i32));
-				std::vector<Graphics::PushConstant> pcVector;
-				pcVector.push_back(*m_PushConstant);
+				pcVector[0] = *m_PushConstant;
 				m_Pipeline->GetDescriptorSet()->SetPushConstants(pcVector);
 
 				Present();
@@ -290,14 +324,11 @@ namespace Lumos
 			}
 
 #ifdef THREAD_CASCADE_GEN
-			System::JobSystem::Dispatch(static_cast<u32>(m_ShadowMapNum), 1, [&](JobDispatchArgs args)
+			System::JobSystem::ParallelFor(0, static_cast<u32>(m_ShadowMapNum), [&](u32 i)
 #else
 			for (uint32_t i = 0; i < m_ShadowMapNum; i++)
 #endif
 			{
-#ifdef THREAD_CASCADE_GEN
-				int i = args.jobIndex;
-#endif
 				float splitDist = cascadeSplits[i];
 				float lastSplitDist = i == 0 ? 0.0f : cascadeSplits[i - 1];
 
@@ -363,7 +394,6 @@ namespace Lumos
 			}
 #ifdef THREAD_CASCADE_GEN
 			);
-			System::JobSystem::Wait();
 #endif
 		}
 
@@ -105,6 +105,12 @@ namespace Lumos
 
 			entt::entity m_LightEntity;
 
+			// Reused every frame to cull all cascades in one pass
+			std::vector<entt::entity> m_CullEntities;
+			std::vector<const Maths::Matrix4*> m_CullWorldMatrices;
+			Maths::BoundingBoxList m_CullBounds;
+			std::vector<u32> m_CullVisibility;
+
 			u32 m_Layer = 0;
 
 			size_t dynamicAlignment{};
@@ -58,6 +58,7 @@
 //Maths
 #include "Maths/Maths.h"
 #include "Maths/Transform.h"
+#include "Maths/TransformStore.h"
 
 //Audio
 #include "Audio/AudioManager.h"
@@ -43,6 +43,16 @@ namespace Lumos::Maths
         for (unsigned i = 0; i < NUM_FRUSTUM_VERTICES; ++i)
             vertices_[i] = rhs.vertices_[i];
 
+    #ifdef Lumos_SSE
+        for (unsigned i = 0; i < NUM_FRUSTUM_SIMD_PLANES; ++i)
+        {
+            planeNormalX_[i] = rhs.planeNormalX_[i];
+            planeNormalY_[i] = rhs.planeNormalY_[i];
+            planeNormalZ_[i] = rhs.planeNormalZ_[i];
+            planeD_[i] = rhs.planeD_[i];
+        }
+    #endif
+
         return *this;
     }
 
@@ -214,5 +224,151 @@ namespace Lumos::Maths
                 plane.d_ = -plane.d_;
             }
         }
+
+    #ifdef Lumos_SSE
+        for (unsigned i = 0; i < NUM_FRUSTUM_SIMD_PLANES; ++i)
+        {
+            const bool padding = i >= NUM_FRUSTUM_PLANES;
+            planeNormalX_[i] = padding ? 0.0f : planes_[i].normal_.x;
+            planeNormalY_[i] = padding ? 0.0f : planes_[i].normal_.y;
+            planeNormalZ_[i] = padding ? 0.0f : planes_[i].normal_.z;
+            planeD_[i] = padding ? M_LARGE_VALUE : planes_[i].d_;
+        }
+    #endif
+    }
+
+    void BoundingBoxList::Clear()
+    {
+        centerX_.clear();
+        centerY_.clear();
+        centerZ_.clear();
+        extentX_.clear();
+        extentY_.clear();
+        extentZ_.clear();
+    }
+
+    void BoundingBoxList::Reserve(unsigned count)
+    {
+        centerX_.reserve(count);
+        centerY_.reserve(count);
+        centerZ_.reserve(count);
+        extentX_.reserve(count);
+        extentY_.reserve(count);
+        extentZ_.reserve(count);
+    }
+
+    unsigned BoundingBoxList::Add(const BoundingBox& box)
+    {
+        Vector3 center = box.Center();
+        Vector3 edge = center - box.min_;
+
+        centerX_.push_back(center.x);
+        centerY_.push_back(center.y);
+        centerZ_.push_back(center.z);
+        extentX_.push_back(edge.x);
+        extentY_.push_back(edge.y);
+        extentZ_.push_back(edge.z);
+
+        return Size() - 1;
+    }
+
+    void CullBoxes(const Frustum* frusta, unsigned frustumCount, const BoundingBoxList& boxes, unsigned* visibility)
+    {
+        const unsigned count = boxes.Size();
+        if (count == 0)
+            return;
+
+        const unsigned words = GetVisibilityWordCount(count);
+        memset(visibility, 0, sizeof(unsigned) * words * frustumCount);
+
+    #ifdef Lumos_SSE
+        // The last partial group of four is copied out so every load is a full one
+        const unsigned fullCount = count & ~3u;
+        float tail[6][4] = {};
+        for (unsigned i = fullCount; i < count; ++i)
+        {
+            tail[0][i - fullCount] = boxes.centerX_[i];
+            tail[1][i - fullCount] = boxes.centerY_[i];
+            tail[2][i - fullCount] = boxes.centerZ_[i];
+            tail[3][i - fullCount] = boxes.extentX_[i];
+            tail[4][i - fullCount] = boxes.extentY_[i];
+            tail[5][i - fullCount] = boxes.extentZ_[i];
+        }
+
+        const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000UL));
+
+        for (unsigned f = 0; f < frustumCount; ++f)
+        {
+            __m128 normalX[NUM_FRUSTUM_PLANES], normalY[NUM_FRUSTUM_PLANES], normalZ[NUM_FRUSTUM_PLANES], d[NUM_FRUSTUM_PLANES];
+            __m128 absNormalX[NUM_FRUSTUM_PLANES], absNormalY[NUM_FRUSTUM_PLANES], absNormalZ[NUM_FRUSTUM_PLANES];
+            for (unsigned p = 0; p < NUM_FRUSTUM_PLANES; ++p)
+            {
+                const Plane& plane = frusta[f].planes_[p];
+                normalX[p] = _mm_set1_ps(plane.normal_.x);
+                normalY[p] = _mm_set1_ps(plane.normal_.y);
+                normalZ[p] = _mm_set1_ps(plane.normal_.z);
+                d[p] = _mm_set1_ps(plane.d_);
+                absNormalX[p] = _mm_set1_ps(plane.absNormal_.x);
+                absNormalY[p] = _mm_set1_ps(plane.absNormal_.y);
+                absNormalZ[p] = _mm_set1_ps(plane.absNormal_.z);
+            }
+
+            unsigned* frustumVisibility = visibility + f * words;
+            for (unsigned i = 0; i < count; i += 4)
+            {
+                const bool full = i < fullCount;
+                const __m128 cx = full ? _mm_loadu_ps(&boxes.centerX_[i]) : _mm_loadu_ps(tail[0]);
+                const __m128 cy = full ? _mm_loadu_ps(&boxes.centerY_[i]) : _mm_loadu_ps(tail[1]);
+                const __m128 cz = full ? _mm_loadu_ps(&boxes.centerZ_[i]) : _mm_loadu_ps(tail[2]);
+                const __m128 ex = full ? _mm_loadu_ps(&boxes.extentX_[i]) : _mm_loadu_ps(tail[3]);
+                const __m128 ey = full ? _mm_loadu_ps(&boxes.extentY_[i]) : _mm_loadu_ps(tail[4]);
+                const __m128 ez = full ? _mm_loadu_ps(&boxes.extentZ_[i]) : _mm_loadu_ps(tail[5]);
+
+                __m128 outside = _mm_setzero_ps();
+                for (unsigned p = 0; p < NUM_FRUSTUM_PLANES; ++p)
+                {
+                    __m128 dist = _mm_mul_ps(normalX[p], cx);
+                    dist = _mm_add_ps(dist, _mm_mul_ps(normalY[p], cy));
+                    dist = _mm_add_ps(dist, _mm_mul_ps(normalZ[p], cz));
+                    dist = _mm_add_ps(dist, d[p]);
+
+                    __m128 absDist = _mm_mul_ps(absNormalX[p], ex);
+                    absDist = _mm_add_ps(absDist, _mm_mul_ps(absNormalY[p], ey));
+                    absDist = _mm_add_ps(absDist, _mm_mul_ps(absNormalZ[p], ez));
+
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_xor_ps(absDist, signMask)));
+                }
+
+                unsigned visible = ~static_cast<unsigned>(_mm_movemask_ps(outside)) & 0xFu;
+                if (!full)
+                    visible &= (1u << (count - i)) - 1u;
+
+                frustumVisibility[i / 32] |= visible << (i % 32);
+            }
+        }
+    #else
+        for (unsigned f = 0; f < frustumCount; ++f)
+        {
+            unsigned* frustumVisibility = visibility + f * words;
+            for (unsigned i = 0; i < count; ++i)
+            {
+                const Vector3 center(boxes.centerX_[i], boxes.centerY_[i], boxes.centerZ_[i]);
+                const Vector3 edge(boxes.extentX_[i], boxes.extentY_[i], boxes.extentZ_[i]);
+
+                bool inside = true;
+                for (const auto& plane : frusta[f].planes_)
+                {
+                    if (plane.normal_.DotProduct(center) + plane.d_ < -plane.absNormal_.DotProduct(edge))
+                    {
+                        inside = false;
+                        break;
+                    }
+                }
+
+                if (inside)
+                    frustumVisibility[i / 32] |= 1u << (i % 32);
+            }
+        }
+    #endif
     }
 }
@@ -6,6 +6,12 @@
 #include "Maths/Rect.h"
 #include "Maths/Sphere.h"
 
+#include <vector>
+
+#ifdef Lumos_SSE
+#include <emmintrin.h>
+#endif
+
 namespace Lumos::Maths
 {
     /// Frustum planes.
@@ -21,6 +27,8 @@ namespace Lumos::Maths
 
     static const unsigned NUM_FRUSTUM_PLANES = 6;
     static const unsigned NUM_FRUSTUM_VERTICES = 8;
+    /// Planes padded to two groups of four for the SSE tests.
+    static const unsigned NUM_FRUSTUM_SIMD_PLANES = 8;
 
     /// Convex constructed of 6 planes.
     class  Frustum
@@ -57,6 +65,18 @@ namespace Lumos::Maths
         /// Test if a point is inside or outside.
         Intersection IsInside(const Vector3& point) const
         {
+    #ifdef Lumos_SSE
+            const __m128 x = _mm_set1_ps(point.x);
+            const __m128 y = _mm_set1_ps(point.y);
+            const __m128 z = _mm_set1_ps(point.z);
+            for (unsigned i = 0; i < NUM_FRUSTUM_SIMD_PLANES; i += 4)
+            {
+                if (_mm_movemask_ps(_mm_cmplt_ps(PlaneDistances(i, x, y, z), _mm_setzero_ps())))
+                    return OUTSIDE;
+            }
+
+            return INSIDE;
+    #else
             for (const auto& plane : planes_)
             {
                 if (plane.Distance(point) < 0.0f)
@@ -64,11 +84,29 @@ namespace Lumos::Maths
             }
 
             return INSIDE;
+    #endif
         }
 
         /// Test if a sphere is inside, outside or intersects.
         Intersection IsInside(const Sphere& sphere) const
         {
+    #ifdef Lumos_SSE
+            const __m128 x = _mm_set1_ps(sphere.center_.x);
+            const __m128 y = _mm_set1_ps(sphere.center_.y);
+            const __m128 z = _mm_set1_ps(sphere.center_.z);
+            const __m128 radius = _mm_set1_ps(sphere.radius_);
+            const __m128 negRadius = _mm_set1_ps(-sphere.radius_);
+            int intersects = 0;
+            for (unsigned i = 0; i < NUM_FRUSTUM_SIMD_PLANES; i += 4)
+            {
+                __m128 dist = PlaneDistances(i, x, y, z);
+                if (_mm_movemask_ps(_mm_cmplt_ps(dist, negRadius)))
+                    return OUTSIDE;
+                intersects |= _mm_movemask_ps(_mm_cmplt_ps(dist, radius));
+            }
+
+            return intersects ? INTERSECTS : INSIDE;
+    #else
             bool allInside = true;
             for (const auto& plane : planes_)
             {
@@ -80,11 +118,25 @@ namespace Lumos::Maths
             }
 
             return allInside ? INSIDE : INTERSECTS;
+    #endif
         }
 
         /// Test if a sphere if (partially) inside or outside.
         Intersection IsInsideFast(const Sphere& sphere) const
         {
+    #ifdef Lumos_SSE
+            const __m128 x = _mm_set1_ps(sphere.center_.x);
+            const __m128 y = _mm_set1_ps(sphere.center_.y);
+            const __m128 z = _mm_set1_ps(sphere.center_.z);
+            const __m128 negRadius = _mm_set1_ps(-sphere.radius_);
+            for (unsigned i = 0; i < NUM_FRUSTUM_SIMD_PLANES; i += 4)
+            {
+                if (_mm_movemask_ps(_mm_cmplt_ps(PlaneDistances(i, x, y, z), negRadius)))
+                    return OUTSIDE;
+            }
+
+            return INSIDE;
+    #else
             for (const auto& plane : planes_)
             {
                 if (plane.Distance(sphere.center_) < -sphere.radius_)
@@ -92,6 +144,7 @@ namespace Lumos::Maths
             }
 
             return INSIDE;
+    #endif
         }
 
         /// Test if a bounding box is inside, outside or intersects.
@@ -99,6 +152,26 @@ namespace Lumos::Maths
         {
             Vector3 center = box.Center();
             Vector3 edge = center - box.min_;
+    #ifdef Lumos_SSE
+            const __m128 cx = _mm_set1_ps(center.x);
+            const __m128 cy = _mm_set1_ps(center.y);
+            const __m128 cz = _mm_set1_ps(center.z);
+            const __m128 ex = _mm_set1_ps(edge.x);
+            const __m128 ey = _mm_set1_ps(edge.y);
+            const __m128 ez = _mm_set1_ps(edge.z);
+            const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000UL));
+            int intersects = 0;
+            for (unsigned i = 0; i < NUM_FRUSTUM_SIMD_PLANES; i += 4)
+            {
+                __m128 dist = PlaneDistances(i, cx, cy, cz);
+                __m128 absDist = PlaneAbsDots(i, ex, ey, ez);
+                if (_mm_movemask_ps(_mm_cmplt_ps(dist, _mm_xor_ps(absDist, signMask))))
+                    return OUTSIDE;
+                intersects |= _mm_movemask_ps(_mm_cmplt_ps(dist, absDist));
+            }
+
+            return intersects ? INTERSECTS : INSIDE;
+    #else
             bool allInside = true;
 
             for (const auto& plane : planes_)
@@ -113,6 +186,7 @@ namespace Lumos::Maths
             }
 
             return allInside ? INSIDE : INTERSECTS;
+    #endif
         }
 
         /// Test if a bounding box is (partially) inside or outside.
@@ -120,6 +194,23 @@ namespace Lumos::Maths
         {
             Vector3 center = box.Center();
             Vector3 edge = center - box.min_;
+    #ifdef Lumos_SSE
+            const __m128 cx = _mm_set1_ps(center.x);
+            const __m128 cy = _mm_set1_ps(center.y);
+            const __m128 cz = _mm_set1_ps(center.z);
+            const __m128 ex = _mm_set1_ps(edge.x);
+            const __m128 ey = _mm_set1_ps(edge.y);
+            const __m128 ez = _mm_set1_ps(edge.z);
+            const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000UL));
+            for (unsigned i = 0; i < NUM_FRUSTUM_SIMD_PLANES; i += 4)
+            {
+                __m128 negAbsDist = _mm_xor_ps(PlaneAbsDots(i, ex, ey, ez), signMask);
+                if (_mm_movemask_ps(_mm_cmplt_ps(PlaneDistances(i, cx, cy, cz), negAbsDist)))
+                    return OUTSIDE;
+            }
+
+            return INSIDE;
+    #else
 
             for (const auto& plane : planes_)
             {
@@ -131,6 +222,7 @@ namespace Lumos::Maths
             }
 
             return INSIDE;
+    #endif
         }
 
         /// Return distance of a point to the frustum, or 0 if inside.
@@ -157,5 +249,61 @@ namespace Lumos::Maths
         Plane planes_[NUM_FRUSTUM_PLANES];
         /// Frustum vertices.
         Vector3 vertices_[NUM_FRUSTUM_VERTICES];
+
+    #ifdef Lumos_SSE
+        /// Plane normals and parameters laid out four planes at a time. The two padding planes never reject.
+        float planeNormalX_[NUM_FRUSTUM_SIMD_PLANES] = {};
+        float planeNormalY_[NUM_FRUSTUM_SIMD_PLANES] = {};
+        float planeNormalZ_[NUM_FRUSTUM_SIMD_PLANES] = {};
+        float planeD_[NUM_FRUSTUM_SIMD_PLANES] = {};
+
+    private:
+        /// Return signed distances of a point to planes first to first + 3.
+        __m128 PlaneDistances(unsigned first, __m128 x, __m128 y, __m128 z) const
+        {
+            __m128 dist = _mm_mul_ps(_mm_loadu_ps(&planeNormalX_[first]), x);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(&planeNormalY_[first]), y));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(&planeNormalZ_[first]), z));
+            return _mm_add_ps(dist, _mm_loadu_ps(&planeD_[first]));
+        }
+
+        /// Return the absolute plane normals of planes first to first + 3 dotted with a box half size.
+        __m128 PlaneAbsDots(unsigned first, __m128 x, __m128 y, __m128 z) const
+        {
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            __m128 dist = _mm_mul_ps(_mm_and_ps(absMask, _mm_loadu_ps(&planeNormalX_[first])), x);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_and_ps(absMask, _mm_loadu_ps(&planeNormalY_[first])), y));
+            return _mm_add_ps(dist, _mm_mul_ps(_mm_and_ps(absMask, _mm_loadu_ps(&planeNormalZ_[first])), z));
+        }
+    #endif
+    };
+
+    /// World-space bounding boxes stored as separate centre and half size arrays, for culling many boxes at once.
+    class BoundingBoxList
+    {
+    public:
+        /// Remove all boxes.
+        void Clear();
+        /// Reserve space for a number of boxes.
+        void Reserve(unsigned count);
+        /// Add a box and return its index.
+        unsigned Add(const BoundingBox& box);
+        /// Return number of boxes.
+        unsigned Size() const { return static_cast<unsigned>(centerX_.size()); }
+
+        /// Box centres.
+        std::vector<float> centerX_, centerY_, centerZ_;
+        /// Box half sizes.
+        std::vector<float> extentX_, extentY_, extentZ_;
     };
+
+    /// Return the number of 32-bit visibility words per frustum for a number of boxes.
+    inline unsigned GetVisibilityWordCount(unsigned boxCount) { return (boxCount + 31) / 32; }
+
+    /// Return whether a box was marked visible in one frustum's visibility words.
+    inline bool IsBoxVisible(const unsigned* visibility, unsigned index) { return (visibility[index / 32] >> (index % 32)) & 1u; }
+
+    /// Test all boxes against several frusta in one pass, with the same result as Frustum::IsInsideFast.
+    /// Visibility for frustum f starts at visibility[f * GetVisibilityWordCount(boxes.Size())] and has one bit per box.
+    void CullBoxes(const Frustum* frusta, unsigned frustumCount, const BoundingBoxList& boxes, unsigned* visibility);
 }
@@ -14,6 +14,7 @@ namespace Lumos
 			m_LocalScale		= Vector3(1.0f, 1.0f, 1.0f);
             m_LocalMatrix		= Matrix4();
             m_WorldMatrix		= Matrix4();
+			m_HasUpdated		= true;
 		}
 
 		Transform::Transform(const Matrix4& matrix)
@@ -23,6 +24,7 @@ namespace Lumos
             m_LocalScale        = matrix.Scale();
 			m_LocalMatrix		= matrix;
 			m_WorldMatrix		= matrix;
+			m_HasUpdated		= true;
 		}
 
 		Transform::Transform(const Vector3& position) 
@@ -39,6 +39,9 @@ namespace Lumos
 			bool HasUpdated() const { return m_HasUpdated; }
 			void SetHasUpdated(bool set) { m_HasUpdated = set; }
 
+			//True when the local transform changed since the SceneGraph last set the world matrix
+			bool IsDirty() const { return m_Dirty || m_HasUpdated; }
+
 			//Sets R,T and S vectors from Local Matrix
 			void ApplyTransform();
 
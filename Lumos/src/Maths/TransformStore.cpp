@@ -0,0 +1,165 @@
+#include "lmpch.h"
+#include "TransformStore.h"
+#include "Core/JobSystem.h"
+#include "Maths/Transform.h"
+
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+	namespace Maths
+	{
+		u32 TransformStore::Add(entt::entity entity)
+		{
+			m_Entities.push_back(entity);
+			m_Positions.emplace_back(0.0f, 0.0f, 0.0f);
+			m_Orientations.push_back(Quaternion::EulerAnglesToQuaternion(0.0f, 0.0f, 0.0f));
+			m_Scales.emplace_back(1.0f, 1.0f, 1.0f);
+			m_WorldMatrices.emplace_back();
+			m_Dirty.push_back(1);
+
+			return Size() - 1;
+		}
+
+		void TransformStore::Remove(u32 index, entt::registry& registry)
+		{
+			const u32 last = Size() - 1;
+			if (index != last)
+			{
+				m_Entities[index] = m_Entities[last];
+				m_Positions[index] = m_Positions[last];
+				m_Orientations[index] = m_Orientations[last];
+				m_Scales[index] = m_Scales[last];
+				m_WorldMatrices[index] = m_WorldMatrices[last];
+				m_Dirty[index] = m_Dirty[last];
+
+				registry.get<SoATransform>(m_Entities[index]).m_Index = index;
+			}
+
+			m_Entities.pop_back();
+			m_Positions.pop_back();
+			m_Orientations.pop_back();
+			m_Scales.pop_back();
+			m_WorldMatrices.pop_back();
+			m_Dirty.pop_back();
+		}
+
+		void TransformStore::UpdateWorldMatrix(u32 index)
+		{
+			if (!m_Dirty[index])
+				return;
+
+			m_WorldMatrices[index] = Matrix4::Translation(m_Positions[index]) * m_Orientations[index].RotationMatrix4() * Matrix4::Scale(m_Scales[index]);
+			m_Dirty[index] = 0;
+		}
+
+		void TransformStore::UpdateWorldMatrices()
+		{
+			System::JobSystem::ParallelForChunked(0, Size(), [this](u32 begin, u32 end)
+			{
+				for (u32 i = begin; i < end; i++)
+					UpdateWorldMatrix(i);
+			});
+		}
+
+		void SoATransform::SetWorldMatrix(const Matrix4& mat)
+		{
+			m_Store->SetWorldMatrix(m_Index, mat * GetLocalMatrix());
+		}
+
+		void SoATransform::SetLocalTransform(const Matrix4& localMat)
+		{
+			m_Store->SetPosition(m_Index, localMat.Translation());
+			m_Store->SetOrientation(m_Index, localMat.Rotation());
+			m_Store->SetScale(m_Index, localMat.Scale());
+		}
+
+		const Matrix4& SoATransform::GetWorldMatrix()
+		{
+			m_Store->UpdateWorldMatrix(m_Index);
+			return m_Store->GetWorldMatrix(m_Index);
+		}
+
+		Matrix4 SoATransform::GetLocalMatrix() const
+		{
+			return Matrix4::Translation(GetLocalPosition()) * GetLocalOrientation().RotationMatrix4() * Matrix4::Scale(GetLocalScale());
+		}
+
+		void SoATransform::OnImGui()
+		{
+			auto rotation = GetLocalOrientation().EulerAngles();
+			auto position = GetLocalPosition();
+			auto scale = GetLocalScale();
+
+			ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2, 2));
+			ImGui::Columns(2);
+			ImGui::Separator();
+
+			ImGui::AlignTextToFramePadding();
+			ImGui::TextUnformatted("Position");
+			ImGui::NextColumn();
+			ImGui::PushItemWidth(-1);
+			if (ImGui::DragFloat3("##Position", Maths::ValuePointer(position)))
+			{
+				SetLocalPosition(position);
+			}
+
+			ImGui::PopItemWidth();
+			ImGui::NextColumn();
+
+			ImGui::AlignTextToFramePadding();
+			ImGui::TextUnformatted("Rotation");
+			ImGui::NextColumn();
+			ImGui::PushItemWidth(-1);
+			if (ImGui::DragFloat3("##Rotation", Maths::ValuePointer(rotation)))
+			{
+				float pitch = Maths::Min(rotation.x, 89.9f);
+				pitch = Maths::Max(pitch, -89.9f);
+				SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(pitch, rotation.y, rotation.z));
+			}
+
+			ImGui::PopItemWidth();
+			ImGui::NextColumn();
+
+			ImGui::AlignTextToFramePadding();
+			ImGui::TextUnformatted("Scale");
+			ImGui::NextColumn();
+			ImGui::PushItemWidth(-1);
+			if (ImGui::DragFloat3("##Scale", Maths::ValuePointer(scale), 0.1f))
+			{
+				SetLocalScale(scale);
+			}
+
+			ImGui::PopItemWidth();
+			ImGui::NextColumn();
+
+			ImGui::Columns(1);
+			ImGui::Separator();
+			ImGui::PopStyleVar();
+		}
+
+		void SoATransform::on_construct(entt::entity entity, entt::registry& registry, SoATransform& transform)
+		{
+			// Systems handle the two transform types in separate passes, an entity with both would be updated twice
+			LUMOS_ASSERT(!registry.has<Transform>(entity), "Entity already has a Transform");
+
+			auto& store = registry.ctx<TransformStore>();
+			transform.m_Store = &store;
+			transform.m_Index = store.Add(entity);
+		}
+
+		void SoATransform::on_replace(entt::entity entity, entt::registry& registry, SoATransform& transform)
+		{
+			// The replacement keeps the slot, the values live in the store
+			const auto& current = registry.get<SoATransform>(entity);
+			transform.m_Store = current.m_Store;
+			transform.m_Index = current.m_Index;
+		}
+
+		void SoATransform::on_destroy(entt::entity entity, entt::registry& registry)
+		{
+			auto& transform = registry.get<SoATransform>(entity);
+			transform.m_Store->Remove(transform.m_Index, registry);
+		}
+	}
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "lmpch.h"
+#include "Maths/Maths.h"
+#include "Core/Serialisable.h"
+
+#include <entt/entt.hpp>
+
+namespace Lumos
+{
+	namespace Maths
+	{
+		//Transforms kept as one array per field, so bulk passes only pull in the fields they use.
+		//Lives in the registry context, set up by SceneGraph::Init. Entities reach their slot through SoATransform.
+		class LUMOS_EXPORT TransformStore
+		{
+		public:
+			u32 Add(entt::entity entity);
+
+			//Moves the last transform into the freed slot
+			void Remove(u32 index, entt::registry& registry);
+
+			//Recomputes the world matrix of every transform changed since the last call
+			void UpdateWorldMatrices();
+
+			//Recomputes a single world matrix, if it changed
+			void UpdateWorldMatrix(u32 index);
+
+			u32 Size() const { return static_cast<u32>(m_Entities.size()); }
+
+			entt::entity GetEntity(u32 index) const { return m_Entities[index]; }
+			bool IsDirty(u32 index) const { return m_Dirty[index] != 0; }
+
+			const Vector3& GetPosition(u32 index) const { return m_Positions[index]; }
+			const Quaternion& GetOrientation(u32 index) const { return m_Orientations[index]; }
+			const Vector3& GetScale(u32 index) const { return m_Scales[index]; }
+			const Matrix4& GetWorldMatrix(u32 index) const { return m_WorldMatrices[index]; }
+
+			void SetPosition(u32 index, const Vector3& position) { m_Positions[index] = position; m_Dirty[index] = 1; }
+			void SetOrientation(u32 index, const Quaternion& orientation) { m_Orientations[index] = orientation; m_Dirty[index] = 1; }
+			void SetScale(u32 index, const Vector3& scale) { m_Scales[index] = scale; m_Dirty[index] = 1; }
+			void SetWorldMatrix(u32 index, const Matrix4& world) { m_WorldMatrices[index] = world; m_Dirty[index] = 0; }
+			void SetDirty(u32 index, bool dirty) { m_Dirty[index] = dirty ? 1 : 0; }
+
+		private:
+			std::vector<entt::entity> m_Entities;
+			std::vector<Vector3> m_Positions;
+			std::vector<Quaternion> m_Orientations;
+			std::vector<Vector3> m_Scales;
+			std::vector<Matrix4> m_WorldMatrices;
+			std::vector<u8> m_Dirty;
+		};
+
+		//Same interface as Transform, backed by a TransformStore slot.
+		//For bulk-updated root entities, these transforms don't take part in the Hierarchy.
+		//An entity has either a Transform or a SoATransform, never both.
+		class LUMOS_EXPORT SoATransform
+		{
+			friend class TransformStore;
+		public:
+			SoATransform() = default;
+
+			void SetWorldMatrix(const Matrix4& mat);
+
+			void SetLocalTransform(const Matrix4& localMat);
+
+			void SetLocalPosition(const Vector3& localPos) { m_Store->SetPosition(m_Index, localPos); }
+			void SetLocalScale(const Vector3& localScale) { m_Store->SetScale(m_Index, localScale); }
+			void SetLocalOrientation(const Quaternion& quat) { m_Store->SetOrientation(m_Index, quat); }
+
+			const Matrix4& GetWorldMatrix();
+			Matrix4 GetLocalMatrix() const;
+
+			const Vector3 GetWorldPosition() const { return m_Store->GetWorldMatrix(m_Index).Translation(); }
+			const Quaternion GetWorldOrientation() const { return m_Store->GetWorldMatrix(m_Index).Rotation(); }
+
+			const Vector3& GetLocalPosition() const { return m_Store->GetPosition(m_Index); }
+			const Vector3& GetLocalScale() const { return m_Store->GetScale(m_Index); }
+			const Quaternion& GetLocalOrientation() const { return m_Store->GetOrientation(m_Index); }
+
+			//Updates the world matrix from R,T and S
+			void UpdateMatrices() { m_Store->UpdateWorldMatrix(m_Index); }
+
+			bool HasUpdated() const { return m_Store->IsDirty(m_Index); }
+			void SetHasUpdated(bool set) { m_Store->SetDirty(m_Index, set); }
+
+			bool IsDirty() const { return m_Store->IsDirty(m_Index); }
+
+			//R,T and S are stored directly, there is no separate local matrix to apply
+			void ApplyTransform() {}
+
+			void OnImGui();
+
+			nlohmann::json Serialise()
+			{
+				nlohmann::json output;
+				output["typeID"] = LUMOS_TYPENAME(SoATransform);
+
+				return output;
+			};
+
+			void Deserialise(nlohmann::json& data)
+			{
+			};
+
+			u32 GetIndex() const { return m_Index; }
+
+			// add to / remove from the TransformStore when the component is added / removed
+			static void on_construct(entt::entity entity, entt::registry& registry, SoATransform& transform);
+			static void on_replace(entt::entity entity, entt::registry& registry, SoATransform& transform);
+			static void on_destroy(entt::entity entity, entt::registry& registry);
+
+		private:
+			TransformStore* m_Store = nullptr;
+			u32 m_Index = 0;
+		};
+	}
+}
@@ -1,6 +1,10 @@
 #pragma once
 #include "Maths/Vector3.h"
 
+#ifdef Lumos_SSE
+#include <emmintrin.h>
+#endif
+
 namespace Lumos::Maths
 {
     /// Four-dimensional vector.
@@ -87,6 +91,13 @@ namespace Lumos::Maths
         {
         }
 
+    #ifdef Lumos_SSE
+        explicit Vector4(__m128 xyzw) noexcept
+        {
+            _mm_storeu_ps(&x, xyzw);
+        }
+    #endif
+
         /// Assign from another vector.
         Vector4& operator =(const Vector4& rhs) noexcept = default;
 
@@ -97,19 +108,47 @@ namespace Lumos::Maths
         bool operator !=(const Vector4& rhs) const { return x != rhs.x || y != rhs.y || z != rhs.z || w != rhs.w; }
 
         /// Add a vector.
-        Vector4 operator +(const Vector4& rhs) const { return Vector4(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w); }
+        Vector4 operator +(const Vector4& rhs) const
+        {
+    #ifdef Lumos_SSE
+            return Vector4(_mm_add_ps(_mm_loadu_ps(&x), _mm_loadu_ps(&rhs.x)));
+    #else
+            return Vector4(x + rhs.x, y + rhs.y, z + rhs.z, w + rhs.w);
+    #endif
+        }
 
         /// Return negation.
         Vector4 operator -() const { return Vector4(-x, -y, -z, -w); }
 
         /// Subtract a vector.
-        Vector4 operator -(const Vector4& rhs) const { return Vector4(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w); }
+        Vector4 operator -(const Vector4& rhs) const
+        {
+    #ifdef Lumos_SSE
+            return Vector4(_mm_sub_ps(_mm_loadu_ps(&x), _mm_loadu_ps(&rhs.x)));
+    #else
+            return Vector4(x - rhs.x, y - rhs.y, z - rhs.z, w - rhs.w);
+    #endif
+        }
 
         /// Multiply with a scalar.
-        Vector4 operator *(float rhs) const { return Vector4(x * rhs, y * rhs, z * rhs, w * rhs); }
+        Vector4 operator *(float rhs) const
+        {
+    #ifdef Lumos_SSE
+            return Vector4(_mm_mul_ps(_mm_loadu_ps(&x), _mm_set1_ps(rhs)));
+    #else
+            return Vector4(x * rhs, y * rhs, z * rhs, w * rhs);
+    #endif
+        }
 
         /// Multiply with a vector.
-        Vector4 operator *(const Vector4& rhs) const { return Vector4(x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w); }
+        Vector4 operator *(const Vector4& rhs) const
+        {
+    #ifdef Lumos_SSE
+            return Vector4(_mm_mul_ps(_mm_loadu_ps(&x), _mm_loadu_ps(&rhs.x)));
+    #else
+            return Vector4(x * rhs.x, y * rhs.y, z * rhs.z, w * rhs.w);
+    #endif
+        }
 
         /// Divide by a scalar.
         Vector4 operator /(float rhs) const { return Vector4(x / rhs, y / rhs, z / rhs, w / rhs); }
@@ -212,7 +251,17 @@ namespace Lumos::Maths
         float& operator[](unsigned index) { return (&x)[index]; }
 
         /// Calculate dot product.
-        float DotProduct(const Vector4& rhs) const { return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w; }
+        float DotProduct(const Vector4& rhs) const
+        {
+    #ifdef Lumos_SSE
+            __m128 n = _mm_mul_ps(_mm_loadu_ps(&x), _mm_loadu_ps(&rhs.x));
+            n = _mm_add_ps(n, _mm_shuffle_ps(n, n, _MM_SHUFFLE(2, 3, 0, 1)));
+            n = _mm_add_ps(n, _mm_shuffle_ps(n, n, _MM_SHUFFLE(0, 1, 2, 3)));
+            return _mm_cvtss_f32(n);
+    #else
+            return x * rhs.x + y * rhs.y + z * rhs.z + w * rhs.w;
+    #endif
+        }
 
         /// Calculate absolute dot product.
         float AbsDotProduct(const Vector4& rhs) const
@@ -224,7 +273,14 @@ namespace Lumos::Maths
         float ProjectOntoAxis(const Vector3& axis) const { return DotProduct(Vector4(axis.Normalized(), 0.0f)); }
 
         /// Return absolute vector.
-        Vector4 Abs() const { return Vector4(Lumos::Maths::Abs(x), Lumos::Maths::Abs(y), Lumos::Maths::Abs(z), Lumos::Maths::Abs(w)); }
+        Vector4 Abs() const
+        {
+    #ifdef Lumos_SSE
+            return Vector4(_mm_and_ps(_mm_loadu_ps(&x), _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))));
+    #else
+            return Vector4(Lumos::Maths::Abs(x), Lumos::Maths::Abs(y), Lumos::Maths::Abs(z), Lumos::Maths::Abs(w));
+    #endif
+        }
 
         /// Linear interpolation with another vector.
         Vector4 Lerp(const Vector4& rhs, float t) const { return *this * (1.0f - t) + rhs * t; }
@@ -21,6 +21,9 @@ namespace Lumos
         , m_UpdateAccum(0.0f)
 	{
         m_DebugName = "Box2D Physics Engine";
+
+		Writes<Physics2DComponent>();
+		Writes<Maths::Transform>();
 	}
 
 	B2PhysicsEngine::~B2PhysicsEngine() = default;
@@ -34,6 +37,7 @@ namespace Lumos
 	void B2PhysicsEngine::OnUpdate(TimeStep* timeStep, Scene* scene)
 	{
 		LUMOS_PROFILE_FUNC;
+		LUMOS_MEMORY_TAG(Physics);
 		const int max_updates_per_frame = 5;
 
 		if (!m_Paused)
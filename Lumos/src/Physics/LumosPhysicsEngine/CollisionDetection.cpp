@@ -10,7 +10,7 @@ namespace Lumos
 	{
 		//max actual size
 		unsigned int maxSize = CollisionShapeTypeMax | (CollisionShapeTypeMax >> 1);
-		m_CollisionCheckFunctions = lmnew CollisionCheckFunc[maxSize];
+		m_CollisionCheckFunctions = lmnew_tagged(Physics) CollisionCheckFunc[maxSize];
 		std::fill(m_CollisionCheckFunctions, m_CollisionCheckFunctions + maxSize, &CollisionDetection::InvalidCheckCollision);
 
 		m_CollisionCheckFunctions[CollisionSphere] = &CollisionDetection::CheckSphereCollision;
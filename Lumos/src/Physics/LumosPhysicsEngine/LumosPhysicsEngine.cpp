@@ -9,9 +9,11 @@
 #include "Utilities/TimeStep.h"
 #include "Core/JobSystem.h"
 #include "Core/Profiler.h"
+#include "Core/OS/Allocators/PoolAllocator.h"
 
 #include "ECS/Component/Physics3DComponent.h"
 #include "Maths/Transform.h"
+#include "Maths/TransformStore.h"
 
 #include <imgui/imgui.h>
 
@@ -30,6 +32,10 @@ namespace Lumos
 	{
         m_DebugName = "Lumos3DPhysicsEngine";
 		m_PhysicsObjects.reserve(100);
+
+		Writes<Physics3DComponent>();
+		Writes<Maths::Transform>();
+		Writes<Maths::SoATransform>();
 	}
 
 	void LumosPhysicsEngine::SetDefaults()
@@ -51,7 +57,7 @@ namespace Lumos
         m_Constraints.clear();
         
         for (Manifold* m : m_Manifolds)
-            delete m;
+            ObjectPool<Manifold>::Get().Delete(m);
         m_Manifolds.clear();
         
 		CollisionDetection::Release();
@@ -60,6 +66,7 @@ namespace Lumos
 	void LumosPhysicsEngine::OnUpdate(TimeStep* timeStep, Scene* scene)
 	{
         LUMOS_PROFILE_BLOCK("LumosPhysicsEngine::OnUpdate");
+		LUMOS_MEMORY_TAG(Physics);
 		if (!m_IsPaused)
 		{
             m_PhysicsObjects.clear();
@@ -67,8 +74,9 @@ namespace Lumos
             auto& registry = scene->GetRegistry();
             
             auto group = registry.group<Physics3DComponent>(entt::get<Maths::Transform>);
+            auto bulkGroup = registry.group(entt::get<Physics3DComponent, Maths::SoATransform>, entt::exclude<Maths::Transform>);
 
-            if (group.empty())
+            if (group.empty() && bulkGroup.empty())
                 return;
             
             for(auto entity : group)
@@ -77,6 +85,14 @@ namespace Lumos
 
                 auto& physicsObj = phys.GetPhysicsObject();
                                
+                if(physicsObj)
+                    m_PhysicsObjects.emplace_back(physicsObj);
+            };
+
+            for(auto entity : bulkGroup)
+            {
+                auto& physicsObj = bulkGroup.get<Physics3DComponent>(entity).GetPhysicsObject();
+
                 if(physicsObj)
                     m_PhysicsObjects.emplace_back(physicsObj);
             };
@@ -112,6 +128,15 @@ namespace Lumos
                 trans.SetLocalPosition(phys.GetPhysicsObject()->GetPosition());
                 trans.SetLocalOrientation(phys.GetPhysicsObject()->GetOrientation());
             };
+
+            // Only writes the position and orientation arrays of the TransformStore
+            for(auto entity : bulkGroup)
+            {
+                const auto &[phys, trans] = bulkGroup.get<Physics3DComponent, Maths::SoATransform>(entity);
+
+                trans.SetLocalPosition(phys.GetPhysicsObject()->GetPosition());
+                trans.SetLocalOrientation(phys.GetPhysicsObject()->GetOrientation());
+            };
 		}
 	}
 
@@ -120,29 +145,38 @@ namespace Lumos
         
 		for (Manifold* m : m_Manifolds)
 		{
-			delete m;
+			ObjectPool<Manifold>::Get().Delete(m);
 		}
 		m_Manifolds.clear();
 
+		//Each stage depends on the previous one. Only this step is waited on, so unrelated jobs keep running meanwhile
+		System::JobSystem::Context broadphase, narrowphase, solver, integration;
+
 		//Check for collisions
-		BroadPhaseCollisions();
-		NarrowPhaseCollisions();
+		System::JobSystem::Execute(broadphase, [this]() { BroadPhaseCollisions(); });
+		System::JobSystem::ExecuteAfter(broadphase, narrowphase, [this]() { NarrowPhaseCollisions(); });
 		
 		//Solve collision constraints
-		SolveConstraints();
+		System::JobSystem::ExecuteAfter(narrowphase, solver, [this]() { SolveConstraints(); });
 		
 		//Update movement
-		UpdatePhysicsObjects();
+		UpdatePhysicsObjects(solver, integration);
+
+		System::JobSystem::WaitFor(integration);
+		System::JobSystem::WaitFor(solver);
+		System::JobSystem::WaitFor(narrowphase);
+		System::JobSystem::WaitFor(broadphase);
 	}
 
-	void LumosPhysicsEngine::UpdatePhysicsObjects()
+	void LumosPhysicsEngine::UpdatePhysicsObjects(System::JobSystem::Context& dependency, System::JobSystem::Context& ctx)
 	{
-        System::JobSystem::Dispatch(static_cast<u32>(m_PhysicsObjects.size()), 4, [&](JobDispatchArgs args)
+        System::JobSystem::ExecuteAfter(dependency, ctx, [this, &ctx]()
         {
-            UpdatePhysicsObject(m_PhysicsObjects[args.jobIndex]);
+            System::JobSystem::ParallelFor(ctx, 0, static_cast<u32>(m_PhysicsObjects.size()), [this](u32 index)
+            {
+                UpdatePhysicsObject(m_PhysicsObjects[index]);
+            });
         });
-        
-        System::JobSystem::Wait();
 	}
 
 	void LumosPhysicsEngine::UpdatePhysicsObject(const Ref<PhysicsObject3D>& obj) const
@@ -299,7 +333,7 @@ namespace Lumos
 						{
 							// Build full collision manifold that will also handle the collision
 							// response between the two objects in the solver stage
-							Manifold* manifold = lmnew Manifold();
+							Manifold* manifold = ObjectPool<Manifold>::Get().New();
 							manifold->Initiate(cp.pObjectA, cp.pObjectB);
 
 							// Construct contact points that form the perimeter of the collision manifold
@@ -314,7 +348,7 @@ namespace Lumos
 							}
 							else
 							{
-								delete manifold;
+								ObjectPool<Manifold>::Get().Delete(manifold);
 							}
 						}
 					}
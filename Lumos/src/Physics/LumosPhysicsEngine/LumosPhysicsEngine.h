@@ -7,6 +7,7 @@
 #include "Broadphase.h"
 #include "ECS/ISystem.h"
 #include "App/Scene.h"
+#include "Core/JobSystem.h"
 
 namespace Lumos
 {
@@ -78,7 +79,8 @@ namespace Lumos
 		void NarrowPhaseCollisions();
 
 		//Updates all physics objects position, orientation, velocity etc (default method uses symplectic euler integration)
-		void UpdatePhysicsObjects();
+		//Runs once dependency has finished, tracked by ctx
+		void UpdatePhysicsObjects(System::JobSystem::Context& dependency, System::JobSystem::Context& ctx);
 		void UpdatePhysicsObject(const Ref<PhysicsObject3D>& obj) const;
 
 		//Solves all engine constraints (constraints and manifolds)
@@ -0,0 +1,26 @@
+#include "lmpch.h"
+#include "HeadlessWindow.h"
+
+namespace Lumos
+{
+	HeadlessWindow::HeadlessWindow(const WindowProperties& properties)
+		: m_Title(properties.Title)
+		, m_Width(properties.Width)
+		, m_Height(properties.Height)
+		, m_Exit(false)
+	{
+		m_Init = true;
+		m_VSync = false;
+		m_HasResized = false;
+	}
+
+	void HeadlessWindow::MakeDefault()
+	{
+		CreateFunc = CreateFuncHeadless;
+	}
+
+	Window* HeadlessWindow::CreateFuncHeadless(const WindowProperties& properties)
+	{
+		return lmnew HeadlessWindow(properties);
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "lmpch.h"
+#include "Core/OS/Window.h"
+
+namespace Lumos
+{
+	// Window without an OS surface or input, for benchmark and CI runs.
+	// Only graphics backends that don't present to a surface can be used with it.
+	class LUMOS_EXPORT HeadlessWindow : public Window
+	{
+	public:
+		HeadlessWindow(const WindowProperties& properties);
+		~HeadlessWindow() = default;
+
+		void ToggleVSync() override { m_VSync = !m_VSync; }
+		void SetVSync(bool set) override { m_VSync = set; }
+		void SetWindowTitle(const String& title) override { m_Title = title; }
+		void SetBorderlessWindow(bool borderless) override {}
+		void OnUpdate() override {}
+		void UpdateCursorImGui() override {}
+		void SetIcon(const String& file, const String& smallIconFilePath = "") override {}
+
+		_FORCE_INLINE_ String GetTitle() const override { return m_Title; }
+		_FORCE_INLINE_ u32 GetWidth()  const override { return m_Width; }
+		_FORCE_INLINE_ u32 GetHeight() const override { return m_Height; }
+		_FORCE_INLINE_ float GetScreenRatio() const override { return (float)m_Width / (float)m_Height; }
+		_FORCE_INLINE_ bool GetExit() const override { return m_Exit; }
+		_FORCE_INLINE_ void SetExit(bool exit) override { m_Exit = exit; }
+		_FORCE_INLINE_ void SetEventCallback(const EventCallbackFn& callback) override { m_EventCallback = callback; }
+
+		static void MakeDefault();
+
+	protected:
+		static Window* CreateFuncHeadless(const WindowProperties& properties);
+
+		String m_Title;
+		u32 m_Width, m_Height;
+		bool m_Exit;
+		EventCallbackFn m_EventCallback;
+	};
+}
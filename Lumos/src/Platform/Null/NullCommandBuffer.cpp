@@ -0,0 +1,18 @@
+#include "lmpch.h"
+#include "NullCommandBuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		void NullCommandBuffer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		CommandBuffer* NullCommandBuffer::CreateFuncNull()
+		{
+			return lmnew NullCommandBuffer();
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/CommandBuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullCommandBuffer : public CommandBuffer
+		{
+		public:
+			NullCommandBuffer() = default;
+			~NullCommandBuffer() = default;
+
+			bool Init(bool primary) override { m_Primary = primary; return true; }
+			void Unload() override {}
+			void BeginRecording() override {}
+			void BeginRecordingSecondary(RenderPass* renderPass, Framebuffer* framebuffer) override {}
+			void EndRecording() override {}
+			void Execute(bool waitFence) override {}
+			void ExecuteSecondary(CommandBuffer* primaryCmdBuffer) override {}
+			void UpdateViewport(u32 width, u32 height) override {}
+
+			static void MakeDefault();
+		protected:
+			static CommandBuffer* CreateFuncNull();
+
+		private:
+			bool m_Primary = true;
+		};
+	}
+}
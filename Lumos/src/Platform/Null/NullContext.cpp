@@ -0,0 +1,33 @@
+#include "lmpch.h"
+#include "NullContext.h"
+#include "NullRenderer.h"
+
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		void NullContext::OnImGui()
+		{
+			auto& stats = NullRenderer::GetLastFrameStats();
+
+			ImGui::TextUnformatted("Null renderer, nothing is sent to a GPU");
+			ImGui::Text("Draw Calls : %u", stats.drawCalls);
+			ImGui::Text("Indices : %llu", static_cast<unsigned long long>(stats.indices));
+			ImGui::Text("State Changes : %u", stats.GetStateChanges());
+			ImGui::Text("Render Passes : %u", stats.renderPasses);
+			ImGui::Text("Bytes Uploaded : %llu", static_cast<unsigned long long>(stats.bytesUploaded));
+		}
+
+		void NullContext::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		GraphicsContext* NullContext::CreateFuncNull(const WindowProperties& properties, void* deviceContext)
+		{
+			return lmnew NullContext(properties, deviceContext);
+		}
+	}
+}
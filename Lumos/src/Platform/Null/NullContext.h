@@ -0,0 +1,26 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/GraphicsContext.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class LUMOS_EXPORT NullContext : public GraphicsContext
+		{
+		public:
+			NullContext(const WindowProperties& properties, void* deviceContext) {}
+			~NullContext() = default;
+
+			void Init() override {}
+			void Present() override {}
+			size_t GetMinUniformBufferOffsetAlignment() const override { return 1; }
+			bool FlipImGUITexture() const override { return false; }
+			void OnImGui() override;
+
+			static void MakeDefault();
+		protected:
+			static GraphicsContext* CreateFuncNull(const WindowProperties& properties, void* deviceContext);
+		};
+	}
+}
@@ -0,0 +1,89 @@
+#include "lmpch.h"
+#include "NullDescriptorSet.h"
+#include "NullRenderer.h"
+#include "NullUniformBuffer.h"
+#include "Graphics/API/Shader.h"
+#include "Graphics/API/Texture.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullDescriptorSet::NullDescriptorSet(const DescriptorInfo& info)
+		{
+			m_Shader = info.shader;
+		}
+
+		void NullDescriptorSet::Update(std::vector<ImageInfo>& imageInfos, std::vector<BufferInfo>& bufferInfos)
+		{
+			m_ImageInfos = imageInfos;
+			m_BufferInfos = bufferInfos;
+		}
+
+		void NullDescriptorSet::Update(std::vector<ImageInfo>& imageInfos)
+		{
+			m_ImageInfos = imageInfos;
+		}
+
+		void NullDescriptorSet::Update(std::vector<BufferInfo>& bufferInfos)
+		{
+			for (auto& bufferInfo : bufferInfos)
+				m_BufferInfos.push_back(bufferInfo);
+		}
+
+		// Same work as binding a GL descriptor set: textures go to their slots and the uniform data is handed to the shader
+		void NullDescriptorSet::Bind(u32 offset)
+		{
+			for (auto& imageInfo : m_ImageInfos)
+			{
+				for (int i = 0; i < imageInfo.count; i++)
+				{
+					if (imageInfo.texture[i])
+						imageInfo.texture[i]->Bind(imageInfo.binding + i);
+				}
+			}
+
+			for (auto& bufferInfo : m_BufferInfos)
+			{
+				auto* buffer = static_cast<NullUniformBuffer*>(bufferInfo.buffer);
+
+				u8* data;
+				u32 size;
+
+				if (buffer->GetDynamic())
+				{
+					data = buffer->GetBuffer() + offset;
+					size = buffer->GetTypeSize();
+				}
+				else
+				{
+					data = buffer->GetBuffer();
+					size = buffer->GetSize();
+				}
+
+				if (bufferInfo.systemUniforms)
+					m_Shader->SetSystemUniformBuffer(bufferInfo.shaderType, data, size);
+				else
+					m_Shader->SetUserUniformBuffer(bufferInfo.shaderType, data, size);
+			}
+
+			for (auto& pushConstant : m_PushConstants)
+				NullRenderer::RecordUpload(pushConstant.size);
+		}
+
+		void NullDescriptorSet::SetPushConstants(std::vector<PushConstant>& pushConstants)
+		{
+			m_PushConstants = pushConstants;
+		}
+
+		void NullDescriptorSet::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		DescriptorSet* NullDescriptorSet::CreateFuncNull(const DescriptorInfo& info)
+		{
+			return lmnew NullDescriptorSet(info);
+		}
+	}
+}
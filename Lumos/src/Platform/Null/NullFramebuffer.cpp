@@ -0,0 +1,66 @@
+#include "lmpch.h"
+#include "NullFramebuffer.h"
+#include "NullRenderer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullFramebuffer::NullFramebuffer(const FramebufferInfo& bufferInfo)
+			: m_Width(bufferInfo.width), m_Height(bufferInfo.height)
+		{
+			if (bufferInfo.attachments)
+				m_AttachmentCount = bufferInfo.attachmentCount;
+		}
+
+		NullFramebuffer::~NullFramebuffer()
+		{
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullFramebuffer::Bind(u32 width, u32 height) const
+		{
+			NullRenderer::BindFramebuffer(this);
+		}
+
+		void NullFramebuffer::Bind() const
+		{
+			NullRenderer::BindFramebuffer(this);
+		}
+
+		void NullFramebuffer::UnBind() const
+		{
+			NullRenderer::BindFramebuffer(nullptr);
+		}
+
+		void NullFramebuffer::AddTextureAttachment(TextureFormat format, Texture* texture)
+		{
+			m_AttachmentCount++;
+		}
+
+		void NullFramebuffer::AddCubeTextureAttachment(TextureFormat format, CubeFace face, TextureCube* texture)
+		{
+			m_AttachmentCount++;
+		}
+
+		void NullFramebuffer::AddShadowAttachment(Texture* texture)
+		{
+			m_AttachmentCount++;
+		}
+
+		void NullFramebuffer::AddTextureLayer(int index, Texture* texture)
+		{
+			m_AttachmentCount++;
+		}
+
+		void NullFramebuffer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		Framebuffer* NullFramebuffer::CreateFuncNull(const FramebufferInfo& info)
+		{
+			return lmnew NullFramebuffer(info);
+		}
+	}
+}
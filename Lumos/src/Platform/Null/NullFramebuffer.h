@@ -0,0 +1,42 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/Framebuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullFramebuffer : public Framebuffer
+		{
+		public:
+			NullFramebuffer(const FramebufferInfo& bufferInfo);
+			~NullFramebuffer();
+
+			void Bind(u32 width, u32 height) const override;
+			void Bind() const override;
+			void UnBind() const override;
+			void Clear() override {}
+
+			void AddTextureAttachment(TextureFormat format, Texture* texture) override;
+			void AddCubeTextureAttachment(TextureFormat format, CubeFace face, TextureCube* texture) override;
+			void AddShadowAttachment(Texture* texture) override;
+			void AddTextureLayer(int index, Texture* texture) override;
+			void GenerateFramebuffer() override {}
+
+			_FORCE_INLINE_ u32 GetWidth() const override { return m_Width; }
+			_FORCE_INLINE_ u32 GetHeight() const override { return m_Height; }
+			u32 GetAttachmentCount() const { return m_AttachmentCount; }
+
+			void SetClearColour(const Maths::Vector4& colour) override {}
+
+			static void MakeDefault();
+		protected:
+			static Framebuffer* CreateFuncNull(const FramebufferInfo& info);
+
+		private:
+			u32 m_Width;
+			u32 m_Height;
+			u32 m_AttachmentCount = 0;
+		};
+	}
+}
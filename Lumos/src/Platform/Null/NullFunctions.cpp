@@ -0,0 +1,41 @@
+#include "lmpch.h"
+#include "NullFunctions.h"
+#include "NullCommandBuffer.h"
+#include "NullContext.h"
+#include "NullDescriptorSet.h"
+#include "NullFramebuffer.h"
+#include "NullIMGUIRenderer.h"
+#include "NullIndexBuffer.h"
+#include "NullPipeline.h"
+#include "NullRenderDevice.h"
+#include "NullRenderer.h"
+#include "NullRenderPass.h"
+#include "NullShader.h"
+#include "NullSwapchain.h"
+#include "NullTexture.h"
+#include "NullUniformBuffer.h"
+#include "NullVertexArray.h"
+#include "NullVertexBuffer.h"
+
+void Lumos::Graphics::Null::MakeDefault()
+{
+	NullCommandBuffer::MakeDefault();
+	NullContext::MakeDefault();
+	NullDescriptorSet::MakeDefault();
+	NullFramebuffer::MakeDefault();
+	NullIMGUIRenderer::MakeDefault();
+	NullIndexBuffer::MakeDefault();
+	NullPipeline::MakeDefault();
+	NullRenderDevice::MakeDefault();
+	NullRenderer::MakeDefault();
+	NullRenderPass::MakeDefault();
+	NullShader::MakeDefault();
+	NullSwapchain::MakeDefault();
+	NullTexture2D::MakeDefault();
+	NullTextureCube::MakeDefault();
+	NullTextureDepth::MakeDefault();
+	NullTextureDepthArray::MakeDefault();
+	NullUniformBuffer::MakeDefault();
+	NullVertexArray::MakeDefault();
+	NullVertexBuffer::MakeDefault();
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		namespace Null
+		{
+			void MakeDefault();
+		}
+	}
+}
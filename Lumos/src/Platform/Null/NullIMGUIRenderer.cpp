@@ -0,0 +1,63 @@
+#include "lmpch.h"
+#include "NullIMGUIRenderer.h"
+#include "NullRenderer.h"
+
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullIMGUIRenderer::NullIMGUIRenderer(u32 width, u32 height, bool clearScreen)
+		{
+		}
+
+		void NullIMGUIRenderer::Init()
+		{
+			ImGuiIO& io = ImGui::GetIO();
+
+			unsigned char* pixels;
+			int width, height;
+			io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+			io.Fonts->SetTexID(reinterpret_cast<ImTextureID>(this));
+
+			NullRenderer::RecordUpload(static_cast<u64>(width) * height * 4);
+		}
+
+		void NullIMGUIRenderer::NewFrame()
+		{
+			if (!ImGui::GetIO().Fonts->IsBuilt())
+				Init();
+		}
+
+		void NullIMGUIRenderer::Render(CommandBuffer* commandBuffer)
+		{
+			ImDrawData* drawData = ImGui::GetDrawData();
+			if (!drawData)
+				return;
+
+			for (int i = 0; i < drawData->CmdListsCount; i++)
+			{
+				const ImDrawList* cmdList = drawData->CmdLists[i];
+				NullRenderer::RecordUpload(cmdList->VtxBuffer.Size * sizeof(ImDrawVert) + cmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
+
+				for (int cmd = 0; cmd < cmdList->CmdBuffer.Size; cmd++)
+				{
+					const ImDrawCmd& drawCmd = cmdList->CmdBuffer[cmd];
+					if (!drawCmd.UserCallback)
+						NullRenderer::RecordDraw(drawCmd.ElemCount);
+				}
+			}
+		}
+
+		void NullIMGUIRenderer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		IMGUIRenderer* NullIMGUIRenderer::CreateFuncNull(u32 width, u32 height, bool clearScreen)
+		{
+			return lmnew NullIMGUIRenderer(width, height, clearScreen);
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/IMGUIRenderer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		// Builds the font atlas on the CPU so ImGui can run, and counts the draw lists instead of drawing them
+		class NullIMGUIRenderer : public IMGUIRenderer
+		{
+		public:
+			NullIMGUIRenderer(u32 width, u32 height, bool clearScreen);
+			~NullIMGUIRenderer() = default;
+
+			void Init() override;
+			void NewFrame() override;
+			void Render(CommandBuffer* commandBuffer) override;
+			void OnResize(u32 width, u32 height) override {}
+			bool Implemented() const override { return true; }
+
+			static void MakeDefault();
+		protected:
+			static IMGUIRenderer* CreateFuncNull(u32 width, u32 height, bool clearScreen);
+		};
+	}
+}
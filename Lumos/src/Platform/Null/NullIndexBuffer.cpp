@@ -0,0 +1,52 @@
+#include "lmpch.h"
+#include "NullIndexBuffer.h"
+#include "NullRenderer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullIndexBuffer::NullIndexBuffer(u16* data, u32 count, BufferUsage bufferUsage)
+			: m_Count(count), m_Size(count * sizeof(u16)), m_Usage(bufferUsage)
+		{
+			NullRenderer::RecordUpload(m_Size);
+		}
+
+		NullIndexBuffer::NullIndexBuffer(u32* data, u32 count, BufferUsage bufferUsage)
+			: m_Count(count), m_Size(count * sizeof(u32)), m_Usage(bufferUsage)
+		{
+			NullRenderer::RecordUpload(m_Size);
+		}
+
+		NullIndexBuffer::~NullIndexBuffer()
+		{
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullIndexBuffer::Bind(CommandBuffer* commandBuffer) const
+		{
+			NullRenderer::BindIndexBuffer(this);
+		}
+
+		void NullIndexBuffer::Unbind() const
+		{
+			NullRenderer::BindIndexBuffer(nullptr);
+		}
+
+		void NullIndexBuffer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+			Create16Func = CreateFunc16Null;
+		}
+
+		IndexBuffer* NullIndexBuffer::CreateFuncNull(u32* data, u32 count, BufferUsage bufferUsage)
+		{
+			return lmnew NullIndexBuffer(data, count, bufferUsage);
+		}
+
+		IndexBuffer* NullIndexBuffer::CreateFunc16Null(u16* data, u32 count, BufferUsage bufferUsage)
+		{
+			return lmnew NullIndexBuffer(data, count, bufferUsage);
+		}
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/IndexBuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullIndexBuffer : public IndexBuffer
+		{
+		private:
+			u32 m_Count;
+			u32 m_Size;
+			BufferUsage m_Usage;
+		public:
+			NullIndexBuffer(u16* data, u32 count, BufferUsage bufferUsage);
+			NullIndexBuffer(u32* data, u32 count, BufferUsage bufferUsage);
+			~NullIndexBuffer();
+
+			void Bind(CommandBuffer* commandBuffer) const override;
+			void Unbind() const override;
+			u32 GetCount() const override { return m_Count; }
+			u32 GetSize() const override { return m_Size; }
+			void SetCount(u32 m_index_count) override { m_Count = m_index_count; };
+
+			static void MakeDefault();
+		protected:
+			static IndexBuffer* CreateFuncNull(u32* data, u32 count, BufferUsage bufferUsage);
+			static IndexBuffer* CreateFunc16Null(u16* data, u32 count, BufferUsage bufferUsage);
+		};
+	}
+}
@@ -0,0 +1,44 @@
+#include "lmpch.h"
+#include "NullPipeline.h"
+#include "NullDescriptorSet.h"
+#include "NullRenderer.h"
+#include "Graphics/API/Shader.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullPipeline::NullPipeline(const PipelineInfo& pipelineCI)
+		{
+			DescriptorInfo info;
+			info.pipeline = this;
+			info.layoutIndex = 0;
+			info.shader = pipelineCI.shader;
+			m_DescriptorSet = lmnew NullDescriptorSet(info);
+
+			m_Shader = info.shader;
+		}
+
+		NullPipeline::~NullPipeline()
+		{
+			NullRenderer::ForgetObject(this);
+			delete m_DescriptorSet;
+		}
+
+		void NullPipeline::SetActive(Graphics::CommandBuffer* cmdBuffer)
+		{
+			NullRenderer::BindPipeline(this);
+			m_Shader->Bind();
+		}
+
+		void NullPipeline::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		Pipeline* NullPipeline::CreateFuncNull(const PipelineInfo& pipelineCI)
+		{
+			return lmnew NullPipeline(pipelineCI);
+		}
+	}
+}
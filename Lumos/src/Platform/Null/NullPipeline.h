@@ -0,0 +1,28 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/Pipeline.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullPipeline : public Pipeline
+		{
+		public:
+			NullPipeline(const PipelineInfo& pipelineCI);
+			~NullPipeline();
+
+			void SetActive(Graphics::CommandBuffer* cmdBuffer) override;
+			DescriptorSet* GetDescriptorSet() const override { return m_DescriptorSet; }
+			Shader* GetShader() const override { return m_Shader; }
+
+			static void MakeDefault();
+		protected:
+			static Pipeline* CreateFuncNull(const PipelineInfo& pipelineCI);
+
+		private:
+			DescriptorSet* m_DescriptorSet = nullptr;
+			Shader* m_Shader = nullptr;
+		};
+	}
+}
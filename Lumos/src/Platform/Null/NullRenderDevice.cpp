@@ -0,0 +1,18 @@
+#include "lmpch.h"
+#include "NullRenderDevice.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		void NullRenderDevice::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		RenderDevice* NullRenderDevice::CreateFuncNull()
+		{
+			return lmnew NullRenderDevice();
+		}
+	}
+}
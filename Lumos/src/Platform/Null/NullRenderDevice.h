@@ -0,0 +1,21 @@
+#pragma once
+#include "Graphics/API/RenderDevice.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullRenderDevice : public RenderDevice
+		{
+		public:
+			NullRenderDevice() = default;
+			~NullRenderDevice() = default;
+
+			void Init() override {}
+
+			static void MakeDefault();
+		protected:
+			static RenderDevice* CreateFuncNull();
+		};
+	}
+}
@@ -0,0 +1,41 @@
+#include "lmpch.h"
+#include "NullRenderPass.h"
+#include "NullRenderer.h"
+#include "Graphics/API/Framebuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		bool NullRenderPass::Init(const RenderpassInfo& renderpassCI)
+		{
+			return true;
+		}
+
+		void NullRenderPass::BeginRenderpass(CommandBuffer* commandBuffer, const Maths::Vector4& clearColour, Framebuffer* frame,
+			SubPassContents contents, uint32_t width, uint32_t height) const
+		{
+			if (frame != nullptr)
+				frame->Bind(width, height);
+			else
+				NullRenderer::BindFramebuffer(nullptr);
+
+			NullRenderer::RecordRenderPass();
+		}
+
+		void NullRenderPass::EndRenderpass(CommandBuffer* commandBuffer)
+		{
+			NullRenderer::BindFramebuffer(nullptr);
+		}
+
+		void NullRenderPass::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		RenderPass* NullRenderPass::CreateFuncNull()
+		{
+			return lmnew NullRenderPass();
+		}
+	}
+}
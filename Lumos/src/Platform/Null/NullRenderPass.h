@@ -0,0 +1,26 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/RenderPass.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullRenderPass : public RenderPass
+		{
+		public:
+			NullRenderPass() = default;
+			~NullRenderPass() = default;
+
+			bool Init(const RenderpassInfo& renderpassCI) override;
+			void Unload() const override {}
+			void BeginRenderpass(CommandBuffer* commandBuffer, const Maths::Vector4& clearColour, Framebuffer* frame,
+				SubPassContents contents, uint32_t width, uint32_t height) const override;
+			void EndRenderpass(CommandBuffer* commandBuffer) override;
+
+			static void MakeDefault();
+		protected:
+			static RenderPass* CreateFuncNull();
+		};
+	}
+}
@@ -0,0 +1,181 @@
+#include "lmpch.h"
+#include "NullRenderer.h"
+#include "NullSwapchain.h"
+#include "NullDescriptorSet.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullFrameStats NullRenderer::s_FrameStats;
+		NullFrameStats NullRenderer::s_LastFrameStats;
+		NullBoundState NullRenderer::s_BoundState;
+		u64 NullRenderer::s_TotalBytesUploaded = 0;
+
+		NullRenderer::NullRenderer(u32 width, u32 height)
+		{
+			m_Swapchain = lmnew NullSwapchain(width, height);
+			m_RendererTitle = "NULL";
+		}
+
+		NullRenderer::~NullRenderer()
+		{
+			delete m_Swapchain;
+		}
+
+		void NullRenderer::InitInternal()
+		{
+			m_Swapchain->Init();
+		}
+
+		void NullRenderer::Begin()
+		{
+			BindFramebuffer(nullptr);
+		}
+
+		void NullRenderer::OnResize(u32 width, u32 height)
+		{
+		}
+
+		void NullRenderer::PresentInternal()
+		{
+			s_LastFrameStats = s_FrameStats;
+			s_FrameStats = NullFrameStats();
+		}
+
+		void NullRenderer::PresentInternal(Graphics::CommandBuffer* cmdBuffer)
+		{
+		}
+
+		void NullRenderer::BindDescriptorSetsInternal(Graphics::Pipeline* pipeline, Graphics::CommandBuffer* cmdBuffer, u32 dynamicOffset, std::vector<Graphics::DescriptorSet*>& descriptorSets)
+		{
+			for (auto descriptor : descriptorSets)
+			{
+				static_cast<Graphics::NullDescriptorSet*>(descriptor)->Bind(dynamicOffset);
+				s_FrameStats.descriptorSetBinds++;
+			}
+		}
+
+		void NullRenderer::DrawInternal(CommandBuffer* commandBuffer, DrawType type, u32 count, DataType dataType, void* indices) const
+		{
+			RecordDraw(count);
+		}
+
+		void NullRenderer::DrawIndexedInternal(CommandBuffer* commandBuffer, DrawType type, u32 count, u32 start) const
+		{
+			RecordDraw(count);
+		}
+
+		Swapchain* NullRenderer::GetSwapchainInternal() const
+		{
+			return m_Swapchain;
+		}
+
+		void NullRenderer::ResetStats()
+		{
+			s_FrameStats = NullFrameStats();
+			s_LastFrameStats = NullFrameStats();
+			s_BoundState = NullBoundState();
+			s_TotalBytesUploaded = 0;
+		}
+
+		void NullRenderer::RecordDraw(u32 indexCount)
+		{
+			s_FrameStats.drawCalls++;
+			s_FrameStats.indices += indexCount;
+		}
+
+		void NullRenderer::RecordUpload(u64 bytes)
+		{
+			s_FrameStats.bytesUploaded += bytes;
+			s_TotalBytesUploaded += bytes;
+		}
+
+		void NullRenderer::BindPipeline(const Pipeline* pipeline)
+		{
+			if (s_BoundState.pipeline != pipeline)
+			{
+				s_BoundState.pipeline = pipeline;
+				s_FrameStats.pipelineChanges++;
+			}
+		}
+
+		void NullRenderer::BindShader(const Shader* shader)
+		{
+			if (s_BoundState.shader != shader)
+			{
+				s_BoundState.shader = shader;
+				s_FrameStats.shaderChanges++;
+			}
+		}
+
+		void NullRenderer::BindVertexBuffer(const VertexBuffer* buffer)
+		{
+			if (s_BoundState.vertexBuffer != buffer)
+			{
+				s_BoundState.vertexBuffer = buffer;
+				s_FrameStats.vertexBufferChanges++;
+			}
+		}
+
+		void NullRenderer::BindIndexBuffer(const IndexBuffer* buffer)
+		{
+			if (s_BoundState.indexBuffer != buffer)
+			{
+				s_BoundState.indexBuffer = buffer;
+				s_FrameStats.indexBufferChanges++;
+			}
+		}
+
+		void NullRenderer::BindFramebuffer(const Framebuffer* framebuffer)
+		{
+			if (s_BoundState.framebuffer != framebuffer)
+			{
+				s_BoundState.framebuffer = framebuffer;
+				s_FrameStats.framebufferChanges++;
+			}
+		}
+
+		void NullRenderer::BindTexture(u32 slot, const Texture* texture)
+		{
+			if (slot >= NULL_MAX_TEXTURE_SLOTS)
+				return;
+
+			if (s_BoundState.textures[slot] != texture)
+			{
+				s_BoundState.textures[slot] = texture;
+				s_FrameStats.textureChanges++;
+			}
+		}
+
+		void NullRenderer::ForgetObject(const void* object)
+		{
+			if (s_BoundState.pipeline == object)
+				s_BoundState.pipeline = nullptr;
+			if (s_BoundState.shader == object)
+				s_BoundState.shader = nullptr;
+			if (s_BoundState.vertexBuffer == object)
+				s_BoundState.vertexBuffer = nullptr;
+			if (s_BoundState.indexBuffer == object)
+				s_BoundState.indexBuffer = nullptr;
+			if (s_BoundState.framebuffer == object)
+				s_BoundState.framebuffer = nullptr;
+
+			for (auto& texture : s_BoundState.textures)
+			{
+				if (texture == object)
+					texture = nullptr;
+			}
+		}
+
+		void NullRenderer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		Renderer* NullRenderer::CreateFuncNull(u32 width, u32 height)
+		{
+			return lmnew NullRenderer(width, height);
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/Renderer.h"
+
+#define NULL_MAX_TEXTURE_SLOTS 16
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullSwapchain;
+		class Pipeline;
+		class Shader;
+		class VertexBuffer;
+		class IndexBuffer;
+		class Framebuffer;
+		class Texture;
+
+		// Counters for one frame of the null backend
+		struct NullFrameStats
+		{
+			u32 drawCalls = 0;
+			u64 indices = 0;
+			u32 pipelineChanges = 0;
+			u32 shaderChanges = 0;
+			u32 descriptorSetBinds = 0;
+			u32 vertexBufferChanges = 0;
+			u32 indexBufferChanges = 0;
+			u32 textureChanges = 0;
+			u32 framebufferChanges = 0;
+			u32 renderPasses = 0;
+			u64 bytesUploaded = 0;
+
+			u32 GetStateChanges() const
+			{
+				return pipelineChanges + shaderChanges + descriptorSetBinds + vertexBufferChanges + indexBufferChanges + textureChanges + framebufferChanges;
+			}
+		};
+
+		// What is currently bound, binding the object that is already bound is not a state change
+		struct NullBoundState
+		{
+			const Pipeline* pipeline = nullptr;
+			const Shader* shader = nullptr;
+			const VertexBuffer* vertexBuffer = nullptr;
+			const IndexBuffer* indexBuffer = nullptr;
+			const Framebuffer* framebuffer = nullptr;
+			const Texture* textures[NULL_MAX_TEXTURE_SLOTS] = {};
+		};
+
+		// Renderer that records draws, binds and uploads in memory instead of talking to a GPU.
+		// Like the GL backend it expects to be driven from the render thread only.
+		class LUMOS_EXPORT NullRenderer : public Renderer
+		{
+		public:
+			NullRenderer(u32 width, u32 height);
+			~NullRenderer();
+
+			void InitInternal() override;
+			void Begin() override;
+			void OnResize(u32 width, u32 height) override;
+			void PresentInternal() override;
+			void PresentInternal(Graphics::CommandBuffer* cmdBuffer) override;
+			void BindDescriptorSetsInternal(Graphics::Pipeline* pipeline, Graphics::CommandBuffer* cmdBuffer, u32 dynamicOffset, std::vector<Graphics::DescriptorSet*>& descriptorSets) override;
+			void DrawInternal(CommandBuffer* commandBuffer, DrawType type, u32 count, DataType dataType, void* indices) const override;
+			void DrawIndexedInternal(CommandBuffer* commandBuffer, DrawType type, u32 count, u32 start) const override;
+
+			Swapchain* GetSwapchainInternal() const override;
+			const String& GetTitleInternal() const override { return m_RendererTitle; }
+
+			// Counters of the frame being recorded, and of the last frame that was presented
+			static const NullFrameStats& GetFrameStats() { return s_FrameStats; }
+			static const NullFrameStats& GetLastFrameStats() { return s_LastFrameStats; }
+			static const NullBoundState& GetBoundState() { return s_BoundState; }
+			static u64 GetTotalBytesUploaded() { return s_TotalBytesUploaded; }
+			static void ResetStats();
+
+			static void RecordDraw(u32 indexCount);
+			static void RecordUpload(u64 bytes);
+			static void RecordRenderPass() { s_FrameStats.renderPasses++; }
+			static void BindPipeline(const Pipeline* pipeline);
+			static void BindShader(const Shader* shader);
+			static void BindVertexBuffer(const VertexBuffer* buffer);
+			static void BindIndexBuffer(const IndexBuffer* buffer);
+			static void BindFramebuffer(const Framebuffer* framebuffer);
+			static void BindTexture(u32 slot, const Texture* texture);
+
+			// Called when an object is destroyed so a new one at the same address still counts as a change
+			static void ForgetObject(const void* object);
+
+			static void MakeDefault();
+		protected:
+			static Renderer* CreateFuncNull(u32 width, u32 height);
+
+			String m_RendererTitle;
+			NullSwapchain* m_Swapchain;
+
+			static NullFrameStats s_FrameStats;
+			static NullFrameStats s_LastFrameStats;
+			static NullBoundState s_BoundState;
+			static u64 s_TotalBytesUploaded;
+		};
+	}
+}
@@ -0,0 +1,56 @@
+#include "lmpch.h"
+#include "NullShader.h"
+#include "NullRenderer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullShader::NullShader(const String& name, const String& filePath)
+			: m_Name(name), m_Path(filePath)
+		{
+			m_ShaderTypes.push_back(ShaderType::VERTEX);
+			m_ShaderTypes.push_back(ShaderType::FRAGMENT);
+		}
+
+		NullShader::~NullShader()
+		{
+			if (s_CurrentlyBound == this)
+				s_CurrentlyBound = nullptr;
+
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullShader::Bind() const
+		{
+			NullRenderer::BindShader(this);
+			s_CurrentlyBound = this;
+		}
+
+		void NullShader::Unbind() const
+		{
+			NullRenderer::BindShader(nullptr);
+			s_CurrentlyBound = nullptr;
+		}
+
+		void NullShader::SetSystemUniformBuffer(ShaderType type, u8* data, u32 size, u32 slot)
+		{
+			NullRenderer::RecordUpload(size);
+		}
+
+		void NullShader::SetUserUniformBuffer(ShaderType type, u8* data, u32 size)
+		{
+			NullRenderer::RecordUpload(size);
+		}
+
+		void NullShader::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		Shader* NullShader::CreateFuncNull(const String& name, const String& filePath)
+		{
+			return lmnew NullShader(name, filePath);
+		}
+	}
+}
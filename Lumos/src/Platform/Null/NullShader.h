@@ -0,0 +1,39 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/Shader.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		// Keeps only the name and path, no sources are read or compiled
+		class NullShader : public Shader
+		{
+		public:
+			NullShader(const String& name, const String& filePath);
+			~NullShader();
+
+			void Bind() const override;
+			void Unbind() const override;
+
+			void SetSystemUniformBuffer(ShaderType type, u8* data, u32 size, u32 slot = 0) override;
+			void SetUserUniformBuffer(ShaderType type, u8* data, u32 size) override;
+
+			const ShaderUniformBufferList GetSystemUniforms(ShaderType type) const override { return ShaderUniformBufferList(); }
+			const ShaderUniformBufferDeclaration* GetUserUniformBuffer(ShaderType type) const override { return nullptr; }
+			const std::vector<ShaderType> GetShaderTypes() const override { return m_ShaderTypes; }
+
+			_FORCE_INLINE_ const String& GetName() const override { return m_Name; }
+			_FORCE_INLINE_ const String& GetFilePath() const override { return m_Path; }
+
+			static void MakeDefault();
+		protected:
+			static Shader* CreateFuncNull(const String& name, const String& filePath);
+
+		private:
+			String m_Name;
+			String m_Path;
+			std::vector<ShaderType> m_ShaderTypes;
+		};
+	}
+}
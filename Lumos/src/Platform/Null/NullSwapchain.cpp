@@ -0,0 +1,50 @@
+#include "lmpch.h"
+#include "NullSwapchain.h"
+#include "NullTexture.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullSwapchain::NullSwapchain(u32 width, u32 height)
+			: m_Width(width), m_Height(height)
+		{
+		}
+
+		NullSwapchain::~NullSwapchain()
+		{
+			delete m_Image;
+		}
+
+		bool NullSwapchain::Init()
+		{
+			if (!m_Image)
+			{
+				m_Image = lmnew NullTexture2D();
+				m_Image->BuildTexture(TextureFormat::RGBA8, m_Width, m_Height, false, false);
+			}
+
+			return true;
+		}
+
+		Texture* NullSwapchain::GetCurrentImage()
+		{
+			return m_Image;
+		}
+
+		Texture* NullSwapchain::GetImage(u32 id)
+		{
+			return m_Image;
+		}
+
+		void NullSwapchain::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		Swapchain* NullSwapchain::CreateFuncNull(u32 width, u32 height)
+		{
+			return lmnew NullSwapchain(width, height);
+		}
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/Swapchain.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullTexture2D;
+
+		class NullSwapchain : public Swapchain
+		{
+		public:
+			NullSwapchain(u32 width, u32 height);
+			~NullSwapchain();
+
+			bool Init() override;
+
+			Texture* GetCurrentImage() override;
+			Texture* GetImage(u32 id) override;
+			uint32_t GetCurrentBufferId() const override { return 0; }
+			size_t GetSwapchainBufferCount() const override { return 1; }
+			u32 GetFramebufferCount() const override { return 1; }
+			Framebuffer* CreateFramebuffer(RenderPass* renderPass, u32 id) override { return nullptr; }
+
+			static void MakeDefault();
+		protected:
+			static Swapchain* CreateFuncNull(u32 width, u32 height);
+
+		private:
+			NullTexture2D* m_Image = nullptr;
+
+			u32 m_Width;
+			u32 m_Height;
+		};
+	}
+}
@@ -0,0 +1,231 @@
+#include "lmpch.h"
+#include "NullTexture.h"
+#include "NullRenderer.h"
+#include "Utilities/LoadImage.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullTexture2D::NullTexture2D()
+		{
+		}
+
+		NullTexture2D::NullTexture2D(u32 width, u32 height, void* data, TextureParameters parameters, TextureLoadOptions loadOptions)
+			: m_FileName("NULL"), m_Width(width), m_Height(height), m_Parameters(parameters), m_LoadOptions(loadOptions)
+		{
+			if (data)
+				SetData(data);
+		}
+
+		NullTexture2D::NullTexture2D(const String& name, const String& filename, TextureParameters parameters, TextureLoadOptions loadOptions)
+			: m_Name(name), m_FileName(filename), m_Parameters(parameters), m_LoadOptions(loadOptions)
+		{
+			// Decoded like the other backends so sizes and upload counts match, then dropped
+			u32 bits = 0;
+			u8* pixels = Lumos::LoadImageFromFile(m_FileName.c_str(), &m_Width, &m_Height, &bits, !m_LoadOptions.flipY);
+			if (pixels)
+			{
+				NullRenderer::RecordUpload(static_cast<u64>(m_Width) * m_Height * (bits / 8));
+				delete[] pixels;
+			}
+		}
+
+		NullTexture2D::~NullTexture2D()
+		{
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullTexture2D::Bind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, this);
+		}
+
+		void NullTexture2D::Unbind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, nullptr);
+		}
+
+		void NullTexture2D::SetData(const void* pixels)
+		{
+			NullRenderer::RecordUpload(static_cast<u64>(m_Width) * m_Height * GetStrideFromFormat(m_Parameters.format));
+		}
+
+		void NullTexture2D::BuildTexture(TextureFormat internalformat, u32 width, u32 height, bool depth, bool samplerShadow)
+		{
+			m_Width = width;
+			m_Height = height;
+			m_Name = "Texture";
+			m_Parameters.format = internalformat;
+		}
+
+		void NullTexture2D::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+			CreateFromSourceFunc = CreateFromSourceFuncNull;
+			CreateFromFileFunc = CreateFromFileFuncNull;
+		}
+
+		Texture2D* NullTexture2D::CreateFuncNull()
+		{
+			return lmnew NullTexture2D();
+		}
+
+		Texture2D* NullTexture2D::CreateFromSourceFuncNull(u32 width, u32 height, void* data, TextureParameters parameters, TextureLoadOptions loadOptions)
+		{
+			return lmnew NullTexture2D(width, height, data, parameters, loadOptions);
+		}
+
+		Texture2D* NullTexture2D::CreateFromFileFuncNull(const String& name, const String& filename, TextureParameters parameters, TextureLoadOptions loadOptions)
+		{
+			return lmnew NullTexture2D(name, filename, parameters, loadOptions);
+		}
+
+		// Cube maps only keep their names, the source images aren't decoded
+		NullTextureCube::NullTextureCube(u32 size)
+			: m_Size(size)
+		{
+			NullRenderer::RecordUpload(static_cast<u64>(size) * size * 4 * 6);
+		}
+
+		NullTextureCube::NullTextureCube(const String& filepath)
+			: m_Name(filepath)
+		{
+			m_Files[0] = filepath;
+		}
+
+		NullTextureCube::NullTextureCube(const String* files)
+			: m_Name(files[0])
+		{
+			for (u32 i = 0; i < 6; i++)
+				m_Files[i] = files[i];
+		}
+
+		NullTextureCube::NullTextureCube(const String* files, u32 mips, InputFormat format)
+			: m_Name(files[0])
+		{
+			for (u32 i = 0; i < mips && i < MAX_MIPS; i++)
+				m_Files[i] = files[i];
+		}
+
+		NullTextureCube::~NullTextureCube()
+		{
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullTextureCube::Bind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, this);
+		}
+
+		void NullTextureCube::Unbind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, nullptr);
+		}
+
+		void NullTextureCube::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+			CreateFromFileFunc = CreateFromFileFuncNull;
+			CreateFromFilesFunc = CreateFromFilesFuncNull;
+			CreateFromVCrossFunc = CreateFromVCrossFuncNull;
+		}
+
+		TextureCube* NullTextureCube::CreateFuncNull(u32 size)
+		{
+			return lmnew NullTextureCube(size);
+		}
+
+		TextureCube* NullTextureCube::CreateFromFileFuncNull(const String& filepath)
+		{
+			return lmnew NullTextureCube(filepath);
+		}
+
+		TextureCube* NullTextureCube::CreateFromFilesFuncNull(const String* files)
+		{
+			return lmnew NullTextureCube(files);
+		}
+
+		TextureCube* NullTextureCube::CreateFromVCrossFuncNull(const String* files, u32 mips, InputFormat format)
+		{
+			return lmnew NullTextureCube(files, mips, format);
+		}
+
+		NullTextureDepth::NullTextureDepth(u32 width, u32 height)
+			: m_Width(width), m_Height(height)
+		{
+		}
+
+		NullTextureDepth::~NullTextureDepth()
+		{
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullTextureDepth::Bind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, this);
+		}
+
+		void NullTextureDepth::Unbind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, nullptr);
+		}
+
+		void NullTextureDepth::Resize(u32 width, u32 height)
+		{
+			m_Width = width;
+			m_Height = height;
+		}
+
+		void NullTextureDepth::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		TextureDepth* NullTextureDepth::CreateFuncNull(u32 width, u32 height)
+		{
+			return lmnew NullTextureDepth(width, height);
+		}
+
+		NullTextureDepthArray::NullTextureDepthArray(u32 width, u32 height, u32 count)
+			: m_Width(width), m_Height(height), m_Count(count)
+		{
+		}
+
+		NullTextureDepthArray::~NullTextureDepthArray()
+		{
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullTextureDepthArray::Bind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, this);
+		}
+
+		void NullTextureDepthArray::Unbind(u32 slot) const
+		{
+			NullRenderer::BindTexture(slot, nullptr);
+		}
+
+		void NullTextureDepthArray::Init()
+		{
+		}
+
+		void NullTextureDepthArray::Resize(u32 width, u32 height, u32 count)
+		{
+			m_Width = width;
+			m_Height = height;
+			m_Count = count;
+		}
+
+		void NullTextureDepthArray::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		TextureDepthArray* NullTextureDepthArray::CreateFuncNull(u32 width, u32 height, u32 count)
+		{
+			return lmnew NullTextureDepthArray(width, height, count);
+		}
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/Texture.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullTexture2D : public Texture2D
+		{
+		public:
+			NullTexture2D(u32 width, u32 height, void* data, TextureParameters parameters = TextureParameters(), TextureLoadOptions loadOptions = TextureLoadOptions());
+			NullTexture2D(const String& name, const String& filename, TextureParameters parameters = TextureParameters(), TextureLoadOptions loadOptions = TextureLoadOptions());
+			NullTexture2D();
+			~NullTexture2D();
+
+			void Bind(u32 slot = 0) const override;
+			void Unbind(u32 slot = 0) const override;
+
+			void SetData(const void* pixels) override;
+
+			void* GetHandle() const override { return (void*)this; }
+
+			_FORCE_INLINE_ u32 GetWidth() const override { return m_Width; }
+			_FORCE_INLINE_ u32 GetHeight() const override { return m_Height; }
+
+			_FORCE_INLINE_ const String& GetName() const override { return m_Name; }
+			_FORCE_INLINE_ const String& GetFilepath() const override { return m_FileName; }
+
+			void BuildTexture(TextureFormat internalformat, u32 width, u32 height, bool depth, bool samplerShadow) override;
+
+			static void MakeDefault();
+		protected:
+			static Texture2D* CreateFuncNull();
+			static Texture2D* CreateFromSourceFuncNull(u32, u32, void*, TextureParameters, TextureLoadOptions);
+			static Texture2D* CreateFromFileFuncNull(const String&, const String&, TextureParameters, TextureLoadOptions);
+
+		private:
+			String m_Name;
+			String m_FileName;
+			u32 m_Width = 0, m_Height = 0;
+			TextureParameters m_Parameters;
+			TextureLoadOptions m_LoadOptions;
+		};
+
+		class NullTextureCube : public TextureCube
+		{
+		public:
+			NullTextureCube(u32 size);
+			NullTextureCube(const String& filepath);
+			NullTextureCube(const String* files);
+			NullTextureCube(const String* files, u32 mips, InputFormat format);
+			~NullTextureCube();
+
+			void* GetHandle() const override { return (void*)this; }
+
+			void Bind(u32 slot = 0) const override;
+			void Unbind(u32 slot = 0) const override;
+
+			_FORCE_INLINE_ u32 GetSize() const override { return m_Size; }
+			_FORCE_INLINE_ const String& GetName() const override { return m_Name; }
+			_FORCE_INLINE_ const String& GetFilepath() const override { return m_Files[0]; }
+
+			static void MakeDefault();
+		protected:
+			static TextureCube* CreateFuncNull(u32);
+			static TextureCube* CreateFromFileFuncNull(const String& filepath);
+			static TextureCube* CreateFromFilesFuncNull(const String* files);
+			static TextureCube* CreateFromVCrossFuncNull(const String* files, u32 mips, InputFormat format);
+
+		private:
+			String m_Name;
+			String m_Files[MAX_MIPS];
+			u32 m_Size = 0;
+		};
+
+		class NullTextureDepth : public TextureDepth
+		{
+		public:
+			NullTextureDepth(u32 width, u32 height);
+			~NullTextureDepth();
+
+			void Bind(u32 slot = 0) const override;
+			void Unbind(u32 slot = 0) const override;
+			void Resize(u32 width, u32 height) override;
+
+			void* GetHandle() const override { return (void*)this; }
+
+			_FORCE_INLINE_ const String& GetName() const override { return m_Name; }
+			_FORCE_INLINE_ const String& GetFilepath() const override { return m_Name; }
+
+			static void MakeDefault();
+		protected:
+			static TextureDepth* CreateFuncNull(u32, u32);
+
+		private:
+			String m_Name;
+			u32 m_Width, m_Height;
+		};
+
+		class NullTextureDepthArray : public TextureDepthArray
+		{
+		public:
+			NullTextureDepthArray(u32 width, u32 height, u32 count);
+			~NullTextureDepthArray();
+
+			void Bind(u32 slot = 0) const override;
+			void Unbind(u32 slot = 0) const override;
+			void Init() override;
+			void Resize(u32 width, u32 height, u32 count) override;
+
+			void* GetHandle() const override { return (void*)this; }
+
+			_FORCE_INLINE_ const String& GetName() const override { return m_Name; }
+			_FORCE_INLINE_ const String& GetFilepath() const override { return m_Name; }
+
+			static void MakeDefault();
+		protected:
+			static TextureDepthArray* CreateFuncNull(u32, u32, u32);
+
+		private:
+			String m_Name;
+			u32 m_Width, m_Height, m_Count;
+		};
+	}
+}
@@ -0,0 +1,51 @@
+#include "lmpch.h"
+#include "NullUniformBuffer.h"
+#include "NullRenderer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		// Like the GL buffer the data isn't copied, the pointer is kept for the descriptor sets
+		void NullUniformBuffer::Init(uint32_t size, const void* data)
+		{
+			m_Data = (u8*)data;
+			m_Size = size;
+			NullRenderer::RecordUpload(size);
+		}
+
+		void NullUniformBuffer::SetDataInternal(uint32_t size, const void* data)
+		{
+			m_Data = (u8*)data;
+			m_Size = size;
+			NullRenderer::RecordUpload(size);
+		}
+
+		void NullUniformBuffer::SetDynamicDataInternal(uint32_t size, uint32_t typeSize, const void* data)
+		{
+			m_Data = (u8*)data;
+			m_Size = size;
+			m_Dynamic = true;
+			m_DynamicTypeSize = typeSize;
+			NullRenderer::RecordUpload(size);
+		}
+
+		void NullUniformBuffer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+			CreateDataFunc = CreateDataFuncNull;
+		}
+
+		UniformBuffer* NullUniformBuffer::CreateFuncNull()
+		{
+			return lmnew NullUniformBuffer();
+		}
+
+		UniformBuffer* NullUniformBuffer::CreateDataFuncNull(uint32_t size, const void* data)
+		{
+			auto buffer = lmnew NullUniformBuffer();
+			buffer->Init(size, data);
+			return buffer;
+		}
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/UniformBuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullUniformBuffer : public UniformBuffer
+		{
+		public:
+			NullUniformBuffer() = default;
+			~NullUniformBuffer() = default;
+
+			void Init(uint32_t size, const void* data) override;
+			void SetDataInternal(uint32_t size, const void* data) override;
+			void SetDynamicDataInternal(uint32_t size, uint32_t typeSize, const void* data) override;
+
+			u8* GetBuffer() const override { return m_Data; };
+
+			uint32_t GetSize()      const { return m_Size; }
+			uint32_t GetTypeSize()  const { return m_DynamicTypeSize; }
+			bool GetDynamic()       const { return m_Dynamic; }
+
+			static void MakeDefault();
+		protected:
+			static UniformBuffer* CreateFuncNull();
+			static UniformBuffer* CreateDataFuncNull(uint32_t, const void*);
+
+		private:
+			u8* m_Data = nullptr;
+			uint32_t m_Size = 0;
+			uint32_t m_DynamicTypeSize = 0;
+			bool m_Dynamic = false;
+		};
+	}
+}
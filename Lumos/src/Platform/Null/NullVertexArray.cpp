@@ -0,0 +1,44 @@
+#include "lmpch.h"
+#include "NullVertexArray.h"
+#include "Graphics/API/VertexBuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullVertexArray::~NullVertexArray()
+		{
+			for (auto buffer : m_Buffers)
+			{
+				delete buffer;
+			}
+		}
+
+		void NullVertexArray::PushBuffer(VertexBuffer* buffer)
+		{
+			m_Buffers.push_back(buffer);
+		}
+
+		void NullVertexArray::Bind(CommandBuffer* commandBuffer) const
+		{
+			if (!m_Buffers.empty())
+				m_Buffers.front()->Bind();
+		}
+
+		void NullVertexArray::Unbind() const
+		{
+			if (!m_Buffers.empty())
+				m_Buffers.front()->Unbind();
+		}
+
+		void NullVertexArray::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		VertexArray* NullVertexArray::CreateFuncNull()
+		{
+			return lmnew NullVertexArray();
+		}
+	}
+}
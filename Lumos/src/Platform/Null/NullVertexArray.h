@@ -0,0 +1,25 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/VertexArray.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullVertexArray : public VertexArray
+		{
+		public:
+			NullVertexArray() = default;
+			~NullVertexArray();
+
+			VertexBuffer* GetBuffer(u32 index = 0) override { return m_Buffers[index]; }
+			void PushBuffer(VertexBuffer* buffer) override;
+			void Bind(CommandBuffer* commandBuffer) const override;
+			void Unbind() const override;
+
+			static void MakeDefault();
+		protected:
+			static VertexArray* CreateFuncNull();
+		};
+	}
+}
@@ -0,0 +1,73 @@
+#include "lmpch.h"
+#include "NullVertexBuffer.h"
+#include "NullRenderer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		NullVertexBuffer::NullVertexBuffer(BufferUsage usage)
+			: m_Usage(usage), m_Size(0)
+		{
+		}
+
+		NullVertexBuffer::~NullVertexBuffer()
+		{
+			NullRenderer::ForgetObject(this);
+		}
+
+		void NullVertexBuffer::Resize(u32 size)
+		{
+			m_Size = size;
+			if (m_Data.size() < size)
+				m_Data.resize(size);
+		}
+
+		void NullVertexBuffer::SetLayout(const Graphics::BufferLayout& bufferLayout)
+		{
+			m_Layout = bufferLayout;
+		}
+
+		void NullVertexBuffer::SetData(u32 size, const void* data)
+		{
+			Resize(size);
+			NullRenderer::RecordUpload(size);
+		}
+
+		void NullVertexBuffer::SetDataSub(u32 size, const void* data, u32 offset)
+		{
+			NullRenderer::RecordUpload(size);
+		}
+
+		// Mapped writes go to CPU memory, the whole mapping counts as uploaded when it is released
+		void* NullVertexBuffer::GetPointerInternal()
+		{
+			return m_Data.data();
+		}
+
+		void NullVertexBuffer::ReleasePointer()
+		{
+			NullRenderer::RecordUpload(m_Size);
+		}
+
+		void NullVertexBuffer::Bind()
+		{
+			NullRenderer::BindVertexBuffer(this);
+		}
+
+		void NullVertexBuffer::Unbind()
+		{
+			NullRenderer::BindVertexBuffer(nullptr);
+		}
+
+		void NullVertexBuffer::MakeDefault()
+		{
+			CreateFunc = CreateFuncNull;
+		}
+
+		VertexBuffer* NullVertexBuffer::CreateFuncNull(const BufferUsage& usage)
+		{
+			return lmnew NullVertexBuffer(usage);
+		}
+	}
+}
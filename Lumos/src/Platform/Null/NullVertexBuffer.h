@@ -0,0 +1,40 @@
+#pragma once
+#include "lmpch.h"
+#include "Graphics/API/VertexBuffer.h"
+
+namespace Lumos
+{
+	namespace Graphics
+	{
+		class NullVertexBuffer : public VertexBuffer
+		{
+		private:
+			BufferUsage m_Usage;
+			u32 m_Size;
+			BufferLayout m_Layout;
+			std::vector<u8> m_Data;
+		public:
+			explicit NullVertexBuffer(BufferUsage usage);
+			~NullVertexBuffer();
+
+			void Resize(u32 size) override;
+			void SetLayout(const BufferLayout& layout) override;
+			void SetData(u32 size, const void* data) override;
+			void SetDataSub(u32 size, const void* data, u32 offset) override;
+
+			void ReleasePointer() override;
+
+			void Bind() override;
+			void Unbind() override;
+
+			u32 GetSize() const { return m_Size; }
+
+			static void MakeDefault();
+		protected:
+			static VertexBuffer* CreateFuncNull(const BufferUsage& usage);
+
+		protected:
+			void* GetPointerInternal() override;
+		};
+	}
+}
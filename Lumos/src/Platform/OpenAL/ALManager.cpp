@@ -4,6 +4,8 @@
 #include "Maths/Maths.h"
 #include "Graphics/Camera/Camera.h"
 #include "Utilities/TimeStep.h"
+#include "ECS/Component/SoundComponent.h"
+#include "ECS/Component/CameraComponent.h"
 
 #include <imgui/imgui.h>
 
@@ -16,6 +18,10 @@ namespace Lumos
 			m_Listener = nullptr;
             
             m_DebugName = "OpenAL Audio";
+
+            // Sound nodes are owned by SoundComponents, the listener by a CameraComponent
+            Reads<SoundComponent>();
+            Reads<CameraComponent>();
 		}
 
 		ALManager::~ALManager()
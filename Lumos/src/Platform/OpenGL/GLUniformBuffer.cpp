@@ -26,7 +26,7 @@ namespace Lumos
 			glBufferData(GL_UNIFORM_BUFFER, m_Size, m_Data, GL_DYNAMIC_DRAW);
 		}
 
-		void GLUniformBuffer::SetData(uint32_t size, const void * data) 
+		void GLUniformBuffer::SetDataInternal(uint32_t size, const void * data) 
 		{
 			m_Data = (u8*)data; 
 			m_Size = size;
@@ -37,7 +37,7 @@ namespace Lumos
 			glUnmapBuffer(GL_UNIFORM_BUFFER);
 		}
 
-		void GLUniformBuffer::SetDynamicData(uint32_t size, uint32_t typeSize, const void * data) 
+		void GLUniformBuffer::SetDynamicDataInternal(uint32_t size, uint32_t typeSize, const void * data) 
 		{ 
 			m_Data = (u8*)data; 
 			m_Size = size; 
@@ -15,8 +15,8 @@ namespace Lumos
             ~GLUniformBuffer();
 
 			void Init(uint32_t size, const void* data) override;
-			void SetData(uint32_t size, const void* data) override;
-			void SetDynamicData(uint32_t size, uint32_t typeSize, const void* data) override;
+			void SetDataInternal(uint32_t size, const void* data) override;
+			void SetDynamicDataInternal(uint32_t size, uint32_t typeSize, const void* data) override;
 
 			void Bind(u32 slot, GLShader* shader, String& name);
 
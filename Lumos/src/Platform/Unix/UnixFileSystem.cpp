@@ -112,8 +112,10 @@ namespace Lumos
     bool FileSystem::WriteTextFile(const String& path, const String& text)
     {
         FILE* file = fopen(path.c_str(), "w");
-        size_t size = fwrite(text.c_str(), 1, sizeof(text), file);
+        if (!file)
+            return false;
+        size_t size = fwrite(text.c_str(), 1, text.size(), file);
         fclose(file);
-        return size > 0;
+        return size == text.size();
     }
 }
@@ -25,14 +25,14 @@ namespace Lumos
 			VKBuffer::Init(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, size, data);
 		}
 
-		void VKUniformBuffer::SetData(uint32_t size, const void* data)
+		void VKUniformBuffer::SetDataInternal(uint32_t size, const void* data)
 		{
 			VKBuffer::Map();
 			memcpy(m_Mapped, data, static_cast<size_t>(size));
 			VKBuffer::UnMap();
 		}
 
-		void VKUniformBuffer::SetDynamicData(uint32_t size, uint32_t typeSize, const void* data)
+		void VKUniformBuffer::SetDynamicDataInternal(uint32_t size, uint32_t typeSize, const void* data)
 		{
 			VKBuffer::Map();
 			memcpy(m_Mapped, data, size);
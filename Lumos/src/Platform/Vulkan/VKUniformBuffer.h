@@ -20,8 +20,9 @@ namespace Lumos
 
 			void Init(uint32_t size, const void* data) override;
 
-			void SetData(uint32_t size, const void* data) override;
-			void SetDynamicData(uint32_t size,  uint32_t typeSize, const void* data) override;
+			using UniformBuffer::SetData;
+			void SetDataInternal(uint32_t size, const void* data) override;
+			void SetDynamicDataInternal(uint32_t size,  uint32_t typeSize, const void* data) override;
 
 			VkBuffer* GetBuffer() { return &m_Buffer; }
 			VkDeviceMemory* GetMemory() { return &m_Memory; }
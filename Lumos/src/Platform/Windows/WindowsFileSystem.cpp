@@ -110,7 +110,14 @@ namespace Lumos
 
 	bool FileSystem::WriteTextFile(const String& path, const String& text)
 	{
-		return WriteFile(path, (u8*)&text[0]);
+		const HANDLE file = CreateFile(path.c_str(), GENERIC_WRITE, NULL, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		DWORD written;
+		const bool result = ::WriteFile(file, text.c_str(), static_cast<DWORD>(text.size()), &written, nullptr) != 0;
+		CloseHandle(file);
+		return result;
 	}
 }
 
@@ -4,19 +4,46 @@
 #include "Maths/Transform.h"
 #include "Core/OS/Window.h"
 #include "Core/VFS.h"
+#include "Core/JobSystem.h"
+#include "Core/OS/MemoryManager.h"
+#include "Core/Profiler.h"
 
 #include <imgui/imgui.h>
 #include <sol/sol.hpp>
 
 namespace Lumos
 {
+	// Lua's heap doesn't go through operator new, route it through Memory so it's counted under Scripting
+	static void* LuaAlloc(void* userData, void* ptr, size_t oldSize, size_t newSize)
+	{
+		if (newSize == 0)
+		{
+			if (ptr)
+				Memory::DeleteFunc(ptr);
+			return nullptr;
+		}
+
+		void* block = Memory::NewFunc(newSize, __FILE__, __LINE__, MemoryTag::Scripting);
+
+		// When ptr is null oldSize holds the object type, not a size. On failure the old block must stay valid
+		if (ptr && block)
+		{
+			memcpy(block, ptr, oldSize < newSize ? oldSize : newSize);
+			Memory::DeleteFunc(ptr);
+		}
+
+		return block;
+	}
+
 	LuaManager::LuaManager() : m_State(nullptr)
 	{
 	}
 
 	void LuaManager::OnInit()
 	{
-		m_State = lmnew sol::state();
+		LUMOS_MEMORY_TAG(Scripting);
+
+		m_State = lmnew_tagged(Scripting) sol::state(sol::default_at_panic, LuaAlloc);
 		m_State->open_libraries(sol::lib::base, sol::lib::package, sol::lib::math);
 
 		BindMathsLua(m_State);
@@ -72,6 +99,31 @@ namespace Lumos
 		windowProperties.Fullscreen = m_State->get<bool>("fullscreen");
 		windowProperties.Borderless = m_State->get<bool>("borderless");
 
+		System::JobSystem::Settings jobSettings;
+		jobSettings.WorkerCount = m_State->get_or("jobWorkerCount", 0u);
+		jobSettings.PinThreads = m_State->get_or("jobPinThreads", false);
+		System::JobSystem::Configure(jobSettings);
+
+		// memoryBudgets = { Renderer = 256, ... } in megabytes, keyed by MemoryTag name
+		sol::optional<sol::table> budgets = (*m_State)["memoryBudgets"];
+		if (budgets)
+		{
+			for (int i = 0; i < static_cast<int>(MemoryTag::Count); ++i)
+			{
+				const MemoryTag tag = static_cast<MemoryTag>(i);
+				const i64 megabytes = budgets->get_or(MemoryManager::GetTagName(tag), 0);
+				MemoryManager::SetBudget(tag, megabytes * 1024 * 1024);
+			}
+		}
+
+		const u32 captureFrames = m_State->get_or("profilerCaptureFrames", 0u);
+		if (captureFrames > 0)
+			Profiler::Instance()->CaptureFrames(captureFrames, m_State->get_or<std::string>("profilerCapturePath", "profiler_capture.json"));
+
+		const float spikeThreshold = m_State->get_or("profilerSpikeThreshold", 0.0f);
+		if (spikeThreshold > 0.0f)
+			Profiler::Instance()->SetSpikeThreshold(spikeThreshold, m_State->get_or("profilerMaxSpikes", 8u));
+
 		return windowProperties;
 	}
 
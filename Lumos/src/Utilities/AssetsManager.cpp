@@ -13,6 +13,8 @@ namespace Lumos
 
 	void AssetsManager::InitializeMeshes()
 	{
+		LUMOS_MEMORY_TAG(Assets);
+
 		s_DefaultModels   = lmnew AssetManager<Graphics::Mesh>();
 		s_DefaultTextures = lmnew AssetManager<Graphics::Texture2D>();
 		s_Sounds = lmnew AssetManager<Sound>();
@@ -0,0 +1,72 @@
+#include "lmpch.h"
+#include "FrameTimeHistory.h"
+
+#include <cmath>
+
+namespace Lumos
+{
+    FrameTimeHistory::FrameTimeHistory(u32 capacity)
+        : m_Next(0)
+        , m_Count(0)
+    {
+        m_Times.resize(std::max(capacity, 1u));
+    }
+
+    void FrameTimeHistory::Add(float frameTime)
+    {
+        m_Times[m_Next] = frameTime;
+        m_Next = (m_Next + 1) % GetCapacity();
+        m_Count = std::min(m_Count + 1, GetCapacity());
+    }
+
+    void FrameTimeHistory::Clear()
+    {
+        m_Next = 0;
+        m_Count = 0;
+    }
+
+    void FrameTimeHistory::SetCapacity(u32 capacity)
+    {
+        std::vector<float> times(std::max(capacity, 1u));
+
+        // Keep the newest frames that still fit
+        const u32 count = std::min(m_Count, static_cast<u32>(times.size()));
+        for (u32 i = 0; i < count; ++i)
+            times[i] = Get(m_Count - count + i);
+
+        m_Times = std::move(times);
+        m_Count = count;
+        m_Next = count % GetCapacity();
+    }
+
+    FrameTimeStats FrameTimeHistory::CalculateStats() const
+    {
+        FrameTimeStats stats;
+        if (m_Count == 0)
+            return stats;
+
+        std::vector<float> sorted(m_Count);
+        for (u32 i = 0; i < m_Count; ++i)
+            sorted[i] = Get(i);
+        std::sort(sorted.begin(), sorted.end());
+
+        // Nearest rank, so p99 of fewer than 100 frames is the slowest one
+        auto percentile = [&sorted](float p)
+        {
+            const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+            return sorted[std::max<size_t>(rank, 1) - 1];
+        };
+
+        float total = 0.0f;
+        for (float time : sorted)
+            total += time;
+
+        stats.frames = m_Count;
+        stats.average = total / m_Count;
+        stats.p50 = percentile(0.50f);
+        stats.p95 = percentile(0.95f);
+        stats.p99 = percentile(0.99f);
+        stats.max = sorted.back();
+        return stats;
+    }
+}
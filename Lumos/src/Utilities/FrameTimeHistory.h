@@ -0,0 +1,41 @@
+#pragma once
+#include "lmpch.h"
+
+namespace Lumos
+{
+    struct FrameTimeStats
+    {
+        float average = 0.0f;
+        float p50 = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+        u32 frames = 0;
+    };
+
+    // Rolling window of the last N frame times in milliseconds, oldest overwritten first
+    class LUMOS_EXPORT FrameTimeHistory
+    {
+    public:
+        explicit FrameTimeHistory(u32 capacity = 600);
+
+        void Add(float frameTime);
+        void Clear();
+        void SetCapacity(u32 capacity);
+
+        // Sorts a copy of the window, call at most once per frame
+        FrameTimeStats CalculateStats() const;
+
+        u32 GetCount() const { return m_Count; }
+        u32 GetCapacity() const { return static_cast<u32>(m_Times.size()); }
+
+        // Oldest first, index < GetCount()
+        float Get(u32 index) const { return m_Times[(m_Next + GetCapacity() - m_Count + index) % GetCapacity()]; }
+        float GetLast() const { return m_Count > 0 ? Get(m_Count - 1) : 0.0f; }
+
+    private:
+        std::vector<float> m_Times;
+        u32 m_Next;
+        u32 m_Count;
+    };
+}
@@ -7,5 +7,14 @@ borderless		    =   false
 vsync			    =   true
 title               =   "Sandbox"
 renderAPI           =   1
+jobWorkerCount      =   0
+jobPinThreads       =   false
+memoryBudgets       =   { Renderer = 512, Physics = 64, Scripting = 32 }
+profilerCaptureFrames = 0
+profilerSpikeThreshold = 0
 
--- OpenGL = 0, Vulkan = 1, Direct3D = 2
\ No newline at end of file
+-- OpenGL = 0, Vulkan = 1, None = 2 (null renderer, draws are only counted)
+-- jobWorkerCount: 0 = one worker per core, minus one for the main thread
+-- memoryBudgets: megabytes per memory tag, a warning is logged when one is exceeded
+-- profilerCaptureFrames: save a Chrome trace of the first n frames to profilerCapturePath (default profiler_capture.json)
+-- profilerSpikeThreshold: keep the profiler events of frames slower than this many milliseconds, 0 = off. profilerMaxSpikes (default 8) are kept
@@ -56,6 +56,7 @@ project "Sandbox"
 			"LUMOS_PLATFORM_WINDOWS",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_WIN32_KHR",
 			"WIN32_LEAN_AND_MEAN",
 			"_CRT_SECURE_NO_WARNINGS",
@@ -118,6 +119,7 @@ project "Sandbox"
 			"LUMOS_PLATFORM_UNIX",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_EXT_metal_surface",
 			"LUMOS_IMGUI"
 		}
@@ -237,6 +239,7 @@ project "Sandbox"
 			"LUMOS_PLATFORM_UNIX",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_XCB_KHR",
 			"LUMOS_IMGUI"
 		}
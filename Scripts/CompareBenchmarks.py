@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+# Compares two Catch benchmark runs and fails when any benchmark got slower.
+#
+#   ./bin/Release/Tests "[!benchmark]" -r xml -o baseline.xml
+#   ./bin/Release/Tests "[!benchmark]" -r xml -o current.xml
+#   python3 Scripts/CompareBenchmarks.py baseline.xml current.xml --threshold 10
+
+import argparse
+import sys
+import xml.etree.ElementTree as ET
+
+
+def load(path):
+    results = {}
+    for test in ET.parse(path).getroot().iter("TestCase"):
+        for bench in test.iter("BenchmarkResults"):
+            mean = bench.find("mean")
+            if mean is not None:
+                results[test.get("name") + " / " + bench.get("name")] = float(mean.get("value"))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare Catch benchmark XML reports")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown in percent")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+
+    regressions = 0
+    for name in sorted(current):
+        if name not in baseline:
+            print("  new  {0}: {1:.0f} ns".format(name, current[name]))
+            continue
+
+        change = (current[name] - baseline[name]) / max(baseline[name], 1.0) * 100.0
+        status = "ok"
+        if change > args.threshold:
+            status = "SLOW"
+            regressions += 1
+        print("{0:>5} {1}: {2:.0f} ns -> {3:.0f} ns ({4:+.1f}%)".format(status, name, baseline[name], current[name], change))
+
+    for name in sorted(set(baseline) - set(current)):
+        print("  gone {0}".format(name))
+
+    if regressions:
+        print("{0} benchmark(s) slower than {1}%".format(regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,429 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include <Core/JobSystem.h>
+#include <Core/OS/Allocators/LinearAllocator.h>
+#include <Core/OS/Allocators/FrameAllocator.h>
+#include <Core/OS/Allocators/PoolAllocator.h>
+#include <Core/OS/Allocators/DefaultAllocator.h>
+#include <Core/OS/Allocators/BinAllocator.h>
+#include <Core/OS/MemoryManager.h>
+
+#include <random>
+
+namespace
+{
+	struct PooledObject
+	{
+		static int s_Alive;
+
+		explicit PooledObject(int value) : value(value) { ++s_Alive; }
+		~PooledObject() { --s_Alive; }
+
+		int value;
+		float padding[15];
+	};
+
+	int PooledObject::s_Alive = 0;
+
+	// Allocates count blocks, frees every other one, refills the holes and then frees everything in random order
+	size_t Churn(Lumos::Allocator& allocator, std::vector<void*>& blocks, size_t size, const std::vector<size_t>& freeOrder)
+	{
+		const size_t count = blocks.size();
+		for (size_t i = 0; i < count; ++i)
+			blocks[i] = allocator.Malloc(size, __FILE__, __LINE__);
+		for (size_t i = 0; i < count; i += 2)
+			allocator.Free(blocks[i]);
+		for (size_t i = 0; i < count; i += 2)
+			blocks[i] = allocator.Malloc(size, __FILE__, __LINE__);
+
+		size_t checksum = 0;
+		for (size_t index : freeOrder)
+		{
+			checksum += reinterpret_cast<uintptr_t>(blocks[index]) & 0xff;
+			allocator.Free(blocks[index]);
+		}
+		return checksum;
+	}
+
+	// Every job allocates a mix of sizes, stamps them, and frees half of what the previous job left behind,
+	// so blocks are regularly freed by a different thread than the one that allocated them
+	bool StressAllocator(Lumos::Allocator& allocator, uint32_t jobCount, uint32_t blocksPerJob)
+	{
+		using namespace Lumos;
+
+		std::vector<std::vector<std::pair<u8*, size_t>>> handoff(jobCount);
+		std::atomic<bool> corrupted(false);
+
+		System::JobSystem::Dispatch(jobCount, 1, [&](JobDispatchArgs args)
+		{
+			std::mt19937 random(args.jobIndex);
+			auto& mine = handoff[args.jobIndex];
+			mine.reserve(blocksPerJob);
+
+			for (uint32_t i = 0; i < blocksPerJob; ++i)
+			{
+				const size_t size = 1 + random() % (i % 16 == 0 ? 4096 : 256);
+				u8* block = static_cast<u8*>(allocator.Malloc(size, __FILE__, __LINE__));
+				memset(block, static_cast<int>(args.jobIndex & 0xff), size);
+				mine.emplace_back(block, size);
+
+				if (i % 2 == 0)
+				{
+					// Free some of our own straight away
+					auto entry = mine.back();
+					mine.pop_back();
+					for (size_t b = 0; b < entry.second; ++b)
+						if (entry.first[b] != static_cast<u8>(args.jobIndex & 0xff))
+							corrupted = true;
+					allocator.Free(entry.first);
+				}
+			}
+		});
+		System::JobSystem::Wait();
+
+		// Free the rest from other threads than the ones that allocated them
+		System::JobSystem::Dispatch(jobCount, 1, [&](JobDispatchArgs args)
+		{
+			const uint32_t owner = (args.jobIndex + 1) % jobCount;
+			for (auto& entry : handoff[owner])
+			{
+				for (size_t b = 0; b < entry.second; ++b)
+					if (entry.first[b] != static_cast<u8>(owner & 0xff))
+						corrupted = true;
+				allocator.Free(entry.first);
+			}
+		});
+		System::JobSystem::Wait();
+
+		return !corrupted;
+	}
+}
+
+TEST_CASE("Linear Allocator", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	LinearAllocator allocator(256);
+
+	void* a = allocator.Allocate(10);
+	void* b = allocator.Allocate(64, 64);
+	REQUIRE(((uintptr_t)a % MEM_ALIGNMENT) == 0);
+	REQUIRE(((uintptr_t)b % 64) == 0);
+	REQUIRE(allocator.GetUsed() == 74);
+
+	// Overflow into more blocks, then get merged into one by Reset
+	for (int i = 0; i < 20; ++i)
+		allocator.Allocate(100);
+	REQUIRE(allocator.GetCapacity() > 256);
+
+	const size_t capacity = allocator.GetCapacity();
+	allocator.Reset();
+	REQUIRE(allocator.GetUsed() == 0);
+	REQUIRE(allocator.GetCapacity() == capacity);
+
+	// Everything now fits in the merged block
+	void* first = allocator.Allocate(100);
+	for (int i = 0; i < 20; ++i)
+		allocator.Allocate(100);
+	REQUIRE(allocator.GetCapacity() == capacity);
+
+	allocator.Reset();
+	REQUIRE(allocator.Allocate(100) == first);
+}
+
+TEST_CASE("Frame Allocator", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	FrameAllocator::OnFrameEnd();
+
+	int* previous = FrameAllocator::AllocateArray<int>(16);
+	for (int i = 0; i < 16; ++i)
+		previous[i] = i;
+
+	FrameVector<u32> values;
+	for (u32 i = 0; i < 1000; ++i)
+		values.push_back(i);
+	REQUIRE(values[999] == 999);
+
+	// Allocations from the workers count as well
+	System::JobSystem::Dispatch(64, 1, [](JobDispatchArgs args)
+	{
+		u8* scratch = FrameAllocator::AllocateArray<u8>(1024);
+		memset(scratch, static_cast<int>(args.jobIndex), 1024);
+	});
+	System::JobSystem::Wait();
+
+	FrameAllocator::OnFrameEnd();
+	REQUIRE(FrameAllocator::GetLastFrameBytes() >= 1000 * sizeof(u32) + 64 * 1024);
+	REQUIRE(FrameAllocator::GetPeakFrameBytes() >= FrameAllocator::GetLastFrameBytes());
+
+	// Last frame's data survives the whole current frame
+	FrameAllocator::AllocateArray<int>(4096);
+	for (int i = 0; i < 16; ++i)
+		REQUIRE(previous[i] == i);
+
+	FrameAllocator::OnFrameEnd();
+	const size_t peak = FrameAllocator::GetPeakFrameBytes();
+	FrameAllocator::OnFrameEnd();
+	REQUIRE(FrameAllocator::GetLastFrameBytes() == 0);
+	REQUIRE(FrameAllocator::GetPeakFrameBytes() == peak);
+}
+
+TEST_CASE("Pool Allocator", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	PoolAllocator allocator(24, 16, 8);
+	REQUIRE(allocator.GetElementSize() == 32);
+
+	std::vector<void*> elements;
+	for (int i = 0; i < 20; ++i)
+	{
+		void* element = allocator.Allocate();
+		REQUIRE(((uintptr_t)element % 16) == 0);
+		REQUIRE(std::find(elements.begin(), elements.end(), element) == elements.end());
+		elements.push_back(element);
+	}
+	REQUIRE(allocator.GetLiveCount() == 20);
+	REQUIRE(allocator.GetCapacity() == 24);
+
+	// Freed elements are reused before growing again
+	allocator.Free(elements[5]);
+	REQUIRE(allocator.Allocate() == elements[5]);
+
+	// Requests that don't fit an element are refused rather than overrunning it
+	void* fits = allocator.Malloc(32, __FILE__, __LINE__);
+	REQUIRE(fits != nullptr);
+	REQUIRE(allocator.Malloc(33, __FILE__, __LINE__) == nullptr);
+	REQUIRE(allocator.GetLiveCount() == 21);
+	allocator.Free(fits);
+
+	for (auto element : elements)
+		allocator.Free(element);
+	REQUIRE(allocator.GetLiveCount() == 0);
+	REQUIRE(allocator.GetCapacity() == 24);
+
+	// Objects are constructed and destroyed in place, PoolRef hands them back
+	{
+		ObjectPool<PooledObject> pool;
+		PooledObject* object = pool.New(7);
+		REQUIRE(object->value == 7);
+		REQUIRE(PooledObject::s_Alive == 1);
+		pool.Delete(object);
+		REQUIRE(PooledObject::s_Alive == 0);
+	}
+
+	{
+		PoolRef<PooledObject> ref = CreatePoolRef<PooledObject>(3);
+		REQUIRE(ref->value == 3);
+		REQUIRE(ObjectPool<PooledObject>::Get().GetAllocator().GetLiveCount() == 1);
+	}
+	REQUIRE(PooledObject::s_Alive == 0);
+	REQUIRE(ObjectPool<PooledObject>::Get().GetAllocator().GetLiveCount() == 0);
+
+	// Allocated and freed from every worker at once
+	ObjectPool<PooledObject> shared(16);
+	System::JobSystem::Dispatch(256, 1, [&shared](JobDispatchArgs args)
+	{
+		PooledObject* objects[32];
+		for (int i = 0; i < 32; ++i)
+			objects[i] = shared.New(static_cast<int>(args.jobIndex));
+		for (int i = 0; i < 32; ++i)
+		{
+			if (objects[i]->value != static_cast<int>(args.jobIndex))
+				FAIL("Pooled object overwritten");
+			shared.Delete(objects[i]);
+		}
+	});
+	System::JobSystem::Wait();
+	REQUIRE(shared.GetAllocator().GetLiveCount() == 0);
+	REQUIRE(PooledObject::s_Alive == 0);
+}
+
+TEST_CASE("Allocator Churn", "[LumosEngine][!benchmark]")
+{
+	using namespace Lumos;
+
+	const size_t count = 10000;
+	const size_t size = 64;
+
+	std::vector<void*> blocks(count);
+	std::vector<size_t> freeOrder(count);
+	for (size_t i = 0; i < count; ++i)
+		freeOrder[i] = i;
+	std::shuffle(freeOrder.begin(), freeOrder.end(), std::mt19937(1234));
+
+	DefaultAllocator defaultAllocator;
+	BENCHMARK("DefaultAllocator: 64 byte churn")
+	{
+		return Churn(defaultAllocator, blocks, size, freeOrder);
+	};
+
+	BinAllocator binAllocator;
+	BENCHMARK("BinAllocator: 64 byte churn")
+	{
+		return Churn(binAllocator, blocks, size, freeOrder);
+	};
+
+	PoolAllocator poolAllocator(size);
+	BENCHMARK("PoolAllocator: 64 byte churn")
+	{
+		return Churn(poolAllocator, blocks, size, freeOrder);
+	};
+}
+
+TEST_CASE("Bin Allocator", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	BinAllocator allocator;
+
+	// Same size class blocks don't overlap, large ones fall back to malloc
+	std::vector<u8*> blocks;
+	for (int i = 0; i < 1000; ++i)
+	{
+		u8* block = static_cast<u8*>(allocator.Malloc(48, __FILE__, __LINE__));
+		REQUIRE(((uintptr_t)block % 16) == 0);
+		memset(block, i & 0xff, 48);
+		blocks.push_back(block);
+	}
+	bool intact = true;
+	for (int i = 0; i < 1000; ++i)
+		intact = intact && blocks[i][47] == (i & 0xff);
+	REQUIRE(intact);
+	for (auto block : blocks)
+		allocator.Free(block);
+
+	void* large = allocator.Malloc(100000, __FILE__, __LINE__);
+	REQUIRE(large != nullptr);
+	allocator.Free(large);
+
+	// Grows past the first region
+	blocks.clear();
+	const size_t blockSize = NUM_BINS * BIN_SIZE_INC;
+	for (size_t i = 0; i < (MEMORY_SIZE / blockSize) + 1000; ++i)
+		blocks.push_back(static_cast<u8*>(allocator.Malloc(blockSize, __FILE__, __LINE__)));
+	REQUIRE(allocator.GetRegionCount() > 1);
+	for (auto block : blocks)
+		allocator.Free(block);
+}
+
+TEST_CASE("Bin Allocator Multithreaded Stress", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	BinAllocator allocator;
+	for (int round = 0; round < 4; ++round)
+		REQUIRE(StressAllocator(allocator, 64, 2000));
+}
+
+TEST_CASE("Allocator Multithreaded Churn", "[LumosEngine][!benchmark]")
+{
+	using namespace Lumos;
+
+	DefaultAllocator defaultAllocator;
+	BENCHMARK("DefaultAllocator: multithreaded churn")
+	{
+		return StressAllocator(defaultAllocator, 64, 2000);
+	};
+
+	BinAllocator binAllocator;
+	BENCHMARK("BinAllocator: multithreaded churn")
+	{
+		return StressAllocator(binAllocator, 64, 2000);
+	};
+}
+
+#ifdef LUMOS_MEMORY_TRACKING
+TEST_CASE("Memory Tags", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	const MemoryTagStats before = MemoryManager::GetTagStats(MemoryTag::Physics);
+
+	void* tagged = Memory::NewFunc(1000, __FILE__, __LINE__, MemoryTag::Physics);
+	REQUIRE(((uintptr_t)tagged % 16) == 0);
+	REQUIRE(MemoryManager::GetTagStats(MemoryTag::Physics).currentUsed == before.currentUsed + 1000);
+
+	// Untagged allocations take the tag of the innermost scope on this thread
+	void* scoped = nullptr;
+	{
+		MemoryTagScope outer(MemoryTag::Audio);
+		{
+			MemoryTagScope inner(MemoryTag::Physics);
+			scoped = Memory::NewFunc(500, __FILE__, __LINE__);
+		}
+		REQUIRE(Memory::GetCurrentTag() == MemoryTag::Audio);
+	}
+	REQUIRE(Memory::GetCurrentTag() == MemoryTag::General);
+
+	MemoryTagStats during = MemoryManager::GetTagStats(MemoryTag::Physics);
+	REQUIRE(during.currentUsed == before.currentUsed + 1500);
+	REQUIRE(during.peakUsed >= during.currentUsed);
+	REQUIRE(during.totalAllocations == before.totalAllocations + 2);
+
+	// Budgets are checked and frame rates rolled over at the end of the frame
+	MemoryManager::SetBudget(MemoryTag::Physics, during.currentUsed - 1);
+	MemoryManager::OnFrameEnd();
+	during = MemoryManager::GetTagStats(MemoryTag::Physics);
+	REQUIRE(during.overBudget);
+	REQUIRE(during.frameAllocations >= 2);
+	REQUIRE(during.frameAllocated >= 1500);
+
+	Memory::DeleteFunc(tagged);
+	Memory::DeleteFunc(scoped);
+	REQUIRE(MemoryManager::GetTagStats(MemoryTag::Physics).currentUsed == before.currentUsed);
+
+	MemoryManager::OnFrameEnd();
+	REQUIRE_FALSE(MemoryManager::GetTagStats(MemoryTag::Physics).overBudget);
+	MemoryManager::SetBudget(MemoryTag::Physics, 0);
+}
+
+TEST_CASE("Memory Tags In Jobs", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	// Warm the job pool up first so its growth isn't charged to the tag below
+	System::JobSystem::Context ctx;
+	for (u32 i = 0; i < 16; i++)
+		System::JobSystem::Execute(ctx, []() {});
+	System::JobSystem::WaitFor(ctx);
+
+	const MemoryTagStats before = MemoryManager::GetTagStats(MemoryTag::Scripting);
+
+	// Jobs take the tag of the thread that submitted them, wherever they run
+	void* allocations[8] = {};
+	MemoryTag seen[8] = {};
+	{
+		MemoryTagScope scope(MemoryTag::Scripting);
+		for (u32 i = 0; i < 8; i++)
+		{
+			System::JobSystem::Execute(ctx, [&allocations, &seen, i]()
+			{
+				seen[i] = Memory::GetCurrentTag();
+				allocations[i] = Memory::NewFunc(700, __FILE__, __LINE__);
+			});
+		}
+	}
+	System::JobSystem::WaitFor(ctx);
+
+	for (u32 i = 0; i < 8; i++)
+		REQUIRE(seen[i] == MemoryTag::Scripting);
+	REQUIRE(MemoryManager::GetTagStats(MemoryTag::Scripting).currentUsed == before.currentUsed + 8 * 700);
+
+	// The tag doesn't leak into later jobs on the same threads
+	MemoryTag after[8] = {};
+	for (u32 i = 0; i < 8; i++)
+		System::JobSystem::Execute(ctx, [&after, i]() { after[i] = Memory::GetCurrentTag(); });
+	System::JobSystem::WaitFor(ctx);
+
+	for (u32 i = 0; i < 8; i++)
+	{
+		REQUIRE(after[i] == MemoryTag::General);
+		Memory::DeleteFunc(allocations[i]);
+	}
+	REQUIRE(MemoryManager::GetTagStats(MemoryTag::Scripting).currentUsed == before.currentUsed);
+}
+#endif
@@ -0,0 +1,389 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include <Core/JobSystem.h>
+
+#include <atomic>
+#include <condition_variable>
+
+namespace
+{
+	// The previous JobSystem implementation (one mutex guarded ring buffer of 256 std::function), kept as a throughput baseline
+	class LegacyJobSystem
+	{
+	public:
+		explicit LegacyJobSystem(uint32_t numThreads) : m_Running(true), m_FinishedLabel(0)
+		{
+			for (uint32_t i = 0; i < numThreads; ++i)
+			{
+				m_Threads.emplace_back([this]
+				{
+					std::function<void()> job;
+					while (m_Running)
+					{
+						if (PopFront(job))
+						{
+							job();
+							m_FinishedLabel.fetch_add(1);
+						}
+						else
+						{
+							std::unique_lock<std::mutex> lock(m_WakeMutex);
+							if (m_Running)
+								m_WakeCondition.wait(lock);
+						}
+					}
+				});
+			}
+		}
+
+		~LegacyJobSystem()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_WakeMutex);
+				m_Running = false;
+			}
+			m_WakeCondition.notify_all();
+
+			for (auto& thread : m_Threads)
+				thread.join();
+		}
+
+		void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(JobDispatchArgs)>& job)
+		{
+			const uint32_t groupCount = (jobCount + groupSize - 1) / groupSize;
+			m_CurrentLabel += groupCount;
+
+			for (uint32_t groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+			{
+				const auto& jobGroup = [jobCount, groupSize, job, groupIndex]()
+				{
+					const uint32_t groupJobOffset = groupIndex * groupSize;
+					const uint32_t groupJobEnd = std::min(groupJobOffset + groupSize, jobCount);
+
+					JobDispatchArgs args;
+					args.groupIndex = groupIndex;
+					for (uint32_t i = groupJobOffset; i < groupJobEnd; ++i)
+					{
+						args.jobIndex = i;
+						job(args);
+					}
+				};
+
+				while (!PushBack(jobGroup)) { Poll(); }
+				m_WakeCondition.notify_one();
+			}
+		}
+
+		void Wait()
+		{
+			while (m_FinishedLabel.load() < m_CurrentLabel) { Poll(); }
+		}
+
+	private:
+		bool PushBack(const std::function<void()>& item)
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			size_t next = (m_Head + 1) % Capacity;
+			if (next == m_Tail)
+				return false;
+			m_Data[m_Head] = item;
+			m_Head = next;
+			return true;
+		}
+
+		bool PopFront(std::function<void()>& item)
+		{
+			std::lock_guard<std::mutex> lock(m_Lock);
+			if (m_Tail == m_Head)
+				return false;
+			item = m_Data[m_Tail];
+			m_Tail = (m_Tail + 1) % Capacity;
+			return true;
+		}
+
+		void Poll()
+		{
+			m_WakeCondition.notify_one();
+			std::this_thread::yield();
+		}
+
+		static const size_t Capacity = 256;
+		std::function<void()> m_Data[Capacity];
+		size_t m_Head = 0;
+		size_t m_Tail = 0;
+		std::mutex m_Lock;
+
+		std::vector<std::thread> m_Threads;
+		std::condition_variable m_WakeCondition;
+		std::mutex m_WakeMutex;
+		std::atomic<bool> m_Running;
+		uint64_t m_CurrentLabel = 0;
+		std::atomic<uint64_t> m_FinishedLabel;
+	};
+}
+
+TEST_CASE("JobSystem Dispatch", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	const uint32_t jobCount = 100000;
+	std::vector<uint32_t> visited(jobCount, 0);
+
+	System::JobSystem::Dispatch(jobCount, 7, [&](JobDispatchArgs args)
+	{
+		visited[args.jobIndex]++;
+	});
+	System::JobSystem::Wait();
+
+	REQUIRE(std::all_of(visited.begin(), visited.end(), [](uint32_t count) { return count == 1; }));
+	REQUIRE(!System::JobSystem::IsBusy());
+}
+
+TEST_CASE("JobSystem Execute Nested", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	// More jobs than the old 256 slot ring buffer, half of them submitted from worker threads
+	std::atomic<uint32_t> counter(0);
+	for (uint32_t i = 0; i < 5000; ++i)
+	{
+		System::JobSystem::Execute([&counter]
+		{
+			counter.fetch_add(1);
+			System::JobSystem::Execute([&counter] { counter.fetch_add(1); });
+		});
+	}
+	System::JobSystem::Wait();
+
+	REQUIRE(counter.load() == 10000);
+}
+
+TEST_CASE("JobSystem Context Continuations", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	// broadphase -> narrowphase -> solver -> integrate
+	std::atomic<uint32_t> stage(0);
+	std::atomic<bool> outOfOrder(false);
+	std::vector<uint32_t> integrated(1000, 0);
+
+	System::JobSystem::Context broadphase, narrowphase, solver, integrate;
+	System::JobSystem::Dispatch(broadphase, 64, 1, [&](JobDispatchArgs) { if (stage.load() != 0) outOfOrder = true; });
+	System::JobSystem::ExecuteAfter(broadphase, narrowphase, [&]() { if (stage.exchange(1) != 0) outOfOrder = true; });
+	System::JobSystem::ExecuteAfter(narrowphase, solver, [&]() { if (stage.exchange(2) != 1) outOfOrder = true; });
+	System::JobSystem::DispatchAfter(solver, integrate, static_cast<uint32_t>(integrated.size()), 16, [&](JobDispatchArgs args)
+	{
+		if (stage.load() != 2)
+			outOfOrder = true;
+		integrated[args.jobIndex]++;
+	});
+
+	System::JobSystem::WaitFor(integrate);
+	System::JobSystem::WaitFor(solver);
+	System::JobSystem::WaitFor(narrowphase);
+	System::JobSystem::WaitFor(broadphase);
+
+	REQUIRE(!outOfOrder);
+	REQUIRE(stage.load() == 2);
+	REQUIRE(std::all_of(integrated.begin(), integrated.end(), [](uint32_t count) { return count == 1; }));
+
+	// A continuation registered on a finished context runs straight away
+	std::atomic<bool> ran(false);
+	System::JobSystem::Context late;
+	System::JobSystem::ExecuteAfter(broadphase, late, [&]() { ran = true; });
+	System::JobSystem::WaitFor(late);
+	REQUIRE(ran);
+}
+
+TEST_CASE("JobSystem Context Independent Wait", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	// Needs one worker for the blocked batch and one for the other
+	if (System::JobSystem::GetThreadCount() < 2)
+		return;
+
+	std::atomic<bool> started(false);
+	std::atomic<bool> release(false);
+	System::JobSystem::Context blocked, other;
+
+	System::JobSystem::Execute(blocked, [&]() { started = true; while (!release) std::this_thread::yield(); });
+
+	// WaitFor helps with any pending job, make sure a worker holds the blocking one first
+	while (!started) std::this_thread::yield();
+
+	std::atomic<uint32_t> counter(0);
+	System::JobSystem::Dispatch(other, 100, 1, [&](JobDispatchArgs) { counter.fetch_add(1); });
+	System::JobSystem::WaitFor(other);
+
+	REQUIRE(counter.load() == 100);
+	REQUIRE(System::JobSystem::IsBusy(blocked));
+
+	release = true;
+	System::JobSystem::WaitFor(blocked);
+	REQUIRE(!System::JobSystem::IsBusy(blocked));
+}
+
+TEST_CASE("JobSystem Allocation Free Submission", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	std::atomic<uint32_t> counter(0);
+	auto job = [&counter](JobDispatchArgs) { counter.fetch_add(1, std::memory_order_relaxed); };
+
+	// Warm up the job pool and the queues, holding the workers back so every job is alive at once
+	std::atomic<bool> release(false);
+	System::JobSystem::Dispatch(20000, 1, [&release](JobDispatchArgs) { while (!release) std::this_thread::yield(); });
+	release = true;
+	System::JobSystem::Wait();
+	System::JobSystem::OnFrameEnd();
+
+	for (uint32_t frame = 0; frame < 3; ++frame)
+	{
+		System::JobSystem::Context ctx;
+		System::JobSystem::Dispatch(ctx, 10000, 1, job);
+		System::JobSystem::WaitFor(ctx);
+		System::JobSystem::Wait();
+		System::JobSystem::OnFrameEnd();
+
+		REQUIRE(System::JobSystem::GetLastFrameAllocationCount() == 0);
+	}
+
+	REQUIRE(counter.load() == 30000);
+}
+
+TEST_CASE("JobSystem Wait Runs Jobs", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	// Occupy every worker, the only thread left to run the other batch is the waiting one
+	const uint32_t threadCount = System::JobSystem::GetThreadCount();
+	std::atomic<uint32_t> started(0);
+	std::atomic<bool> release(false);
+	System::JobSystem::Context blocked, other;
+
+	System::JobSystem::Dispatch(blocked, threadCount, 1, [&](JobDispatchArgs)
+	{
+		started.fetch_add(1);
+		while (!release) std::this_thread::yield();
+	});
+	while (started.load() < threadCount) std::this_thread::yield();
+
+	const std::thread::id caller = std::this_thread::get_id();
+	std::atomic<uint32_t> onCaller(0);
+	System::JobSystem::Dispatch(other, 100, 1, [&](JobDispatchArgs)
+	{
+		if (std::this_thread::get_id() == caller)
+			onCaller.fetch_add(1);
+	});
+	System::JobSystem::WaitFor(other);
+
+	REQUIRE(onCaller.load() == 100);
+
+	release = true;
+	System::JobSystem::WaitFor(blocked);
+}
+
+TEST_CASE("JobSystem ParallelFor", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	for (uint32_t count : { 0u, 1u, 7u, 1000u, 100000u })
+	{
+		std::vector<uint32_t> visited(count, 0);
+		System::JobSystem::ParallelFor(0, count, [&visited](uint32_t index)
+		{
+			// Enough work per item for the large ranges to be split
+			volatile float x = 0.0f;
+			for (uint32_t i = 0; i < 100; ++i)
+				x = x + float(i);
+			visited[index]++;
+		});
+
+		REQUIRE(std::all_of(visited.begin(), visited.end(), [](uint32_t visits) { return visits == 1; }));
+	}
+
+	// Chunks cover the range exactly once
+	std::vector<uint32_t> visited(50000, 0);
+	System::JobSystem::ParallelForChunked(100, 50000, [&visited](uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; ++i)
+			visited[i]++;
+	});
+	REQUIRE(std::all_of(visited.begin(), visited.begin() + 100, [](uint32_t visits) { return visits == 0; }));
+	REQUIRE(std::all_of(visited.begin() + 100, visited.end(), [](uint32_t visits) { return visits == 1; }));
+
+	// Cheap ranges don't leave the calling thread
+	const std::thread::id caller = std::this_thread::get_id();
+	std::atomic<bool> offThread(false);
+	for (uint32_t frame = 0; frame < 4; ++frame)
+	{
+		System::JobSystem::ParallelFor(0, 16, [&](uint32_t)
+		{
+			if (std::this_thread::get_id() != caller)
+				offThread = true;
+		});
+	}
+	REQUIRE(!offThread);
+}
+
+TEST_CASE("JobSystem Configure", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	const uint32_t previousCount = System::JobSystem::GetThreadCount();
+
+	System::JobSystem::Settings settings;
+	settings.WorkerCount = 3;
+	System::JobSystem::Configure(settings);
+	REQUIRE(System::JobSystem::GetThreadCount() == 3);
+
+	std::atomic<uint32_t> counter(0);
+	System::JobSystem::Dispatch(1000, 1, [&counter](JobDispatchArgs) { counter.fetch_add(1); });
+	System::JobSystem::Wait();
+	REQUIRE(counter.load() == 1000);
+
+#ifdef LUMOS_PLATFORM_LINUX
+	// Workers are named after their index, skip the jobs the waiting thread picks up
+	const std::thread::id caller = std::this_thread::get_id();
+	std::atomic<bool> named(true);
+	System::JobSystem::Dispatch(64, 1, [&named, caller](JobDispatchArgs)
+	{
+		char name[16] = {};
+		pthread_getname_np(pthread_self(), name, sizeof(name));
+		if (std::this_thread::get_id() != caller && strncmp(name, "JobSystem_", 10) != 0)
+			named = false;
+	});
+	System::JobSystem::Wait();
+	REQUIRE(named);
+#endif
+
+	settings.WorkerCount = previousCount;
+	System::JobSystem::Configure(settings);
+	REQUIRE(System::JobSystem::GetThreadCount() == previousCount);
+}
+
+TEST_CASE("JobSystem Throughput", "[LumosEngine][!benchmark]")
+{
+	using namespace Lumos;
+
+	const uint32_t jobCount = 1000000;
+	std::atomic<uint32_t> counter(0);
+	auto tinyJob = [&counter](JobDispatchArgs) { counter.fetch_add(1, std::memory_order_relaxed); };
+
+	BENCHMARK("Work stealing: 1M tiny jobs")
+	{
+		System::JobSystem::Dispatch(jobCount, 1, tinyJob);
+		System::JobSystem::Wait();
+		return counter.load();
+	};
+
+	LegacyJobSystem legacy(System::JobSystem::GetThreadCount());
+	BENCHMARK("Legacy ring buffer: 1M tiny jobs")
+	{
+		legacy.Dispatch(jobCount, 1, tinyJob);
+		legacy.Wait();
+		return counter.load();
+	};
+}
@@ -0,0 +1,185 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include <Maths/Frustum.h>
+#include <Maths/Ray.h>
+#include <random>
+
+// Build with and without "--no-sse" and compare runs with Scripts/CompareBenchmarks.py.
+// Each benchmark works on the same fixed batch of inputs so results line up across commits.
+#ifdef Lumos_SSE
+#define MATHS_PATH "SSE"
+#else
+#define MATHS_PATH "Scalar"
+#endif
+
+namespace
+{
+	using namespace Lumos::Maths;
+
+	const size_t BatchSize = 1024;
+
+	struct MathsInputs
+	{
+		std::vector<Vector3> points;
+		std::vector<Quaternion> rotations;
+		std::vector<Matrix4> matrices;
+		std::vector<BoundingBox> boxes;
+		std::vector<Ray> rays;
+
+		MathsInputs()
+		{
+			std::mt19937 rng(1234);
+			std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+			std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+			std::uniform_real_distribution<float> extent(0.1f, 5.0f);
+
+			for (size_t i = 0; i < BatchSize; i++)
+			{
+				Vector3 point(position(rng), position(rng), position(rng));
+				Quaternion rotation(angle(rng), angle(rng), angle(rng));
+				Vector3 halfSize(extent(rng), extent(rng), extent(rng));
+
+				points.push_back(point);
+				rotations.push_back(rotation);
+				matrices.push_back(Matrix3x4(point, rotation, halfSize).ToMatrix4());
+				boxes.push_back(BoundingBox(point - halfSize, point + halfSize));
+				rays.push_back(Ray(Vector3::ZERO, point.Normalized()));
+			}
+		}
+	};
+}
+
+TEST_CASE("Maths Benchmark (" MATHS_PATH ")", "[LumosEngine][!benchmark]")
+{
+	static const MathsInputs inputs;
+
+	BENCHMARK("Vector3: 1024 cross, dot and normalize")
+	{
+		float sum = 0.0f;
+		for (size_t i = 1; i < BatchSize; i++)
+		{
+			Vector3 cross = inputs.points[i].CrossProduct(inputs.points[i - 1]);
+			sum += cross.Normalized().DotProduct(inputs.points[i]) + (inputs.points[i] * 0.5f + cross).Length();
+		}
+		return sum;
+	};
+
+	BENCHMARK("Matrix4: 1024 multiplies")
+	{
+		Matrix4 result = Matrix4::IDENTITY;
+		for (size_t i = 0; i < BatchSize; i++)
+			result = inputs.matrices[i] * result;
+		return result;
+	};
+
+	BENCHMARK("Matrix4: 1024 inverses")
+	{
+		float sum = 0.0f;
+		for (size_t i = 0; i < BatchSize; i++)
+			sum += inputs.matrices[i].Inverse().m00_;
+		return sum;
+	};
+
+	BENCHMARK("Matrix4: 1024 point transforms")
+	{
+		Vector3 sum = Vector3::ZERO;
+		for (size_t i = 0; i < BatchSize; i++)
+			sum += inputs.matrices[i] * inputs.points[i];
+		return sum;
+	};
+
+	BENCHMARK("Quaternion: 1024 slerps")
+	{
+		Quaternion result = Quaternion::IDENTITY;
+		for (size_t i = 1; i < BatchSize; i++)
+			result = result * inputs.rotations[i].Slerp(inputs.rotations[i - 1], 0.3f);
+		return result;
+	};
+
+	BENCHMARK("Quaternion: 1024 vector rotations")
+	{
+		Vector3 sum = Vector3::ZERO;
+		for (size_t i = 0; i < BatchSize; i++)
+			sum += inputs.rotations[i] * inputs.points[i];
+		return sum;
+	};
+
+	BENCHMARK("BoundingBox: 1024 transforms")
+	{
+		BoundingBox merged;
+		for (size_t i = 0; i < BatchSize; i++)
+			merged.Merge(inputs.boxes[i].Transformed(inputs.matrices[i]));
+		return merged;
+	};
+
+	Frustum frustum;
+	frustum.Define(Matrix4::Perspective(0.1f, 150.0f, 16.0f / 9.0f, 60.0f));
+
+	BENCHMARK("Frustum: 1024 fast box tests")
+	{
+		u32 visible = 0;
+		for (size_t i = 0; i < BatchSize; i++)
+			if (frustum.IsInsideFast(inputs.boxes[i]) != Intersection::OUTSIDE)
+				visible++;
+		return visible;
+	};
+
+	BoundingBoxList boxList;
+	for (const auto& box : inputs.boxes)
+		boxList.Add(box);
+
+	Frustum cascades[4];
+	for (u32 i = 0; i < 4; i++)
+		cascades[i].Define(Matrix4::Perspective(0.1f + i * 25.0f, 25.0f + i * 25.0f, 16.0f / 9.0f, 60.0f));
+
+	std::vector<u32> visibility(GetVisibilityWordCount(BatchSize) * 4);
+
+	BENCHMARK("Frustum: 1024 boxes batch culled")
+	{
+		CullBoxes(&frustum, 1, boxList, visibility.data());
+		return visibility[0];
+	};
+
+	BENCHMARK("Frustum: 1024 boxes x 4 cascades, one at a time")
+	{
+		u32 visible = 0;
+		for (u32 c = 0; c < 4; c++)
+			for (size_t i = 0; i < BatchSize; i++)
+				if (cascades[c].IsInsideFast(inputs.boxes[i]) != Intersection::OUTSIDE)
+					visible++;
+		return visible;
+	};
+
+	BENCHMARK("Frustum: 1024 boxes x 4 cascades batch culled")
+	{
+		CullBoxes(cascades, 4, boxList, visibility.data());
+		return visibility[0];
+	};
+
+	BENCHMARK("Ray: 1024 box hits")
+	{
+		float sum = 0.0f;
+		for (size_t i = 0; i < BatchSize; i++)
+		{
+			float distance = inputs.rays[i].HitDistance(inputs.boxes[(i + 1) % BatchSize]);
+			if (distance < M_INFINITY)
+				sum += distance;
+		}
+		return sum;
+	};
+
+	BENCHMARK("Ray: 1024 sphere and plane hits")
+	{
+		float sum = 0.0f;
+		const Plane ground(Vector3::UP, Vector3::ZERO);
+		for (size_t i = 0; i < BatchSize; i++)
+		{
+			const Sphere sphere(inputs.points[(i + 1) % BatchSize], 2.0f);
+			float distance = Min(inputs.rays[i].HitDistance(sphere), inputs.rays[i].HitDistance(ground));
+			if (distance < M_INFINITY)
+				sum += distance;
+		}
+		return sum;
+	};
+}
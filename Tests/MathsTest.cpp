@@ -1,6 +1,8 @@
 #include <catch.hpp>
 
 #include <LumosEngine.h>
+#include <Maths/Frustum.h>
+#include <random>
 
 TEST_CASE("Vector2 Tests", "[Lumos::Maths]")
 {
@@ -666,3 +668,168 @@ SCENARIO("Quaternion Tests", "[Lumos::Maths]")
 	}
 
 }
+
+namespace
+{
+	bool Near(float a, float b)
+	{
+		using namespace Lumos::Maths;
+		return Abs(a - b) <= 1e-4f * Max(1.0f, Max(Abs(a), Abs(b)));
+	}
+
+	bool Near(const Lumos::Maths::Vector3& a, const Lumos::Maths::Vector3& b)
+	{
+		return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z);
+	}
+}
+
+// Checks whichever path Lumos_SSE selected against plain scalar formulas
+TEST_CASE("Maths SIMD Equivalence", "[Lumos::Maths]")
+{
+	using namespace Lumos::Maths;
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> value(-50.0f, 50.0f);
+	std::uniform_real_distribution<float> angle(-180.0f, 180.0f);
+	std::uniform_real_distribution<float> extent(0.1f, 10.0f);
+
+	Frustum frustum;
+	frustum.Define(60.0f, 16.0f / 9.0f, 1.0f, 0.1f, 80.0f, Matrix3x4(Vector3(5.0f, -2.0f, 3.0f), Quaternion(20.0f, 45.0f, 0.0f), 1.0f));
+
+	for (int i = 0; i < 256; i++)
+	{
+		Vector4 a(value(rng), value(rng), value(rng), value(rng));
+		Vector4 b(value(rng), value(rng), value(rng), value(rng));
+		REQUIRE((a + b).Equals(Vector4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w)));
+		REQUIRE((a - b).Equals(Vector4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w)));
+		REQUIRE((a * b).Equals(Vector4(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w)));
+		REQUIRE((a * 0.5f).Equals(Vector4(a.x * 0.5f, a.y * 0.5f, a.z * 0.5f, a.w * 0.5f)));
+		REQUIRE(Near(a.DotProduct(b), a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w));
+		REQUIRE(a.Abs() == Vector4(Abs(a.x), Abs(a.y), Abs(a.z), Abs(a.w)));
+
+		Quaternion p(angle(rng), angle(rng), angle(rng));
+		Quaternion q(angle(rng), angle(rng), angle(rng));
+		Quaternion pq = p * q;
+		REQUIRE(Near(pq.w, p.w * q.w - p.x * q.x - p.y * q.y - p.z * q.z));
+		REQUIRE(Near(pq.x, p.w * q.x + p.x * q.w + p.y * q.z - p.z * q.y));
+		REQUIRE(Near(pq.y, p.w * q.y + p.y * q.w + p.z * q.x - p.x * q.z));
+		REQUIRE(Near(pq.z, p.w * q.z + p.z * q.w + p.x * q.y - p.y * q.x));
+
+		Vector3 point(value(rng), value(rng), value(rng));
+		REQUIRE(Near(p * point, p.RotationMatrix() * point));
+
+		Matrix4 m = Matrix3x4(point, p, Vector3(extent(rng), extent(rng), extent(rng))).ToMatrix4();
+		Matrix4 n = Matrix3x4(a.ToVector3(), q, extent(rng)).ToMatrix4();
+		Matrix4 mn = m * n;
+		for (unsigned row = 0; row < 4; row++)
+			for (unsigned col = 0; col < 4; col++)
+			{
+				float sum = 0.0f;
+				for (unsigned k = 0; k < 4; k++)
+					sum += m.Element(row, k) * n.Element(k, col);
+				REQUIRE(Near(mn.Element(row, col), sum));
+			}
+
+		Vector3 halfSize(extent(rng), extent(rng), extent(rng));
+		BoundingBox box(point - halfSize, point + halfSize);
+		BoundingBox expected;
+		for (int corner = 0; corner < 8; corner++)
+		{
+			Vector3 v((corner & 1) ? box.max_.x : box.min_.x, (corner & 2) ? box.max_.y : box.min_.y, (corner & 4) ? box.max_.z : box.min_.z);
+			expected.Merge(m * v);
+		}
+		BoundingBox transformed = box.Transformed(m);
+		REQUIRE(Near(transformed.min_, expected.min_));
+		REQUIRE(Near(transformed.max_, expected.max_));
+
+		// Scalar plane tests straight from the frustum planes
+		Vector3 center = box.Center();
+		Vector3 edge = center - box.min_;
+		Intersection boxResult = INSIDE;
+		Intersection sphereResult = INSIDE;
+		Intersection pointResult = INSIDE;
+		const Sphere sphere(point, halfSize.x);
+		for (const auto& plane : frustum.planes_)
+		{
+			float dist = plane.normal_.DotProduct(center) + plane.d_;
+			float absDist = plane.absNormal_.DotProduct(edge);
+			if (dist < -absDist)
+				boxResult = OUTSIDE;
+			else if (dist < absDist && boxResult == INSIDE)
+				boxResult = INTERSECTS;
+
+			float sphereDist = plane.Distance(sphere.center_);
+			if (sphereDist < -sphere.radius_)
+				sphereResult = OUTSIDE;
+			else if (sphereDist < sphere.radius_ && sphereResult == INSIDE)
+				sphereResult = INTERSECTS;
+
+			if (plane.Distance(point) < 0.0f)
+				pointResult = OUTSIDE;
+		}
+
+		REQUIRE(frustum.IsInside(box) == boxResult);
+		REQUIRE(frustum.IsInsideFast(box) == (boxResult == OUTSIDE ? OUTSIDE : INSIDE));
+		REQUIRE(frustum.IsInside(sphere) == sphereResult);
+		REQUIRE(frustum.IsInsideFast(sphere) == (sphereResult == OUTSIDE ? OUTSIDE : INSIDE));
+		REQUIRE(frustum.IsInside(point) == pointResult);
+	}
+
+	// Copies keep the packed planes
+	Frustum copy = frustum;
+	REQUIRE(copy.IsInside(Vector3(5.0f, -2.0f, 3.0f)) == frustum.IsInside(Vector3(5.0f, -2.0f, 3.0f)));
+	REQUIRE(copy.IsInside(Sphere(Vector3(5.0f, -2.0f, 3.0f), 1.0f)) == INTERSECTS);
+}
+
+TEST_CASE("Frustum Batch Culling", "[Lumos::Maths]")
+{
+	using namespace Lumos::Maths;
+
+	std::mt19937 rng(7);
+	std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> extent(0.1f, 10.0f);
+
+	Frustum frusta[3];
+	frusta[0].Define(60.0f, 1.0f, 1.0f, 0.1f, 100.0f);
+	frusta[1].Define(Matrix4::Perspective(0.1f, 50.0f, 16.0f / 9.0f, 45.0f));
+	frusta[2].DefineOrtho(80.0f, 1.0f, 1.0f, 0.0f, 60.0f, Matrix3x4(Vector3(10.0f, 0.0f, -20.0f), Quaternion(0.0f, 90.0f, 0.0f), 1.0f));
+
+	// Not a multiple of four so the partial last group is covered
+	const unsigned count = 1003;
+	std::vector<BoundingBox> boxes;
+	BoundingBoxList list;
+	for (unsigned i = 0; i < count; i++)
+	{
+		Vector3 center(value(rng), value(rng), value(rng));
+		Vector3 halfSize(extent(rng), extent(rng), extent(rng));
+		boxes.push_back(BoundingBox(center - halfSize, center + halfSize));
+		REQUIRE(list.Add(boxes.back()) == i);
+	}
+
+	const unsigned words = GetVisibilityWordCount(count);
+	REQUIRE(words == 32);
+
+	std::vector<unsigned> visibility(words * 3, 0xFFFFFFFFu);
+	CullBoxes(frusta, 3, list, visibility.data());
+
+	for (unsigned f = 0; f < 3; f++)
+	{
+		unsigned visibleCount = 0;
+		for (unsigned i = 0; i < count; i++)
+		{
+			const bool visible = IsBoxVisible(visibility.data() + f * words, i);
+			REQUIRE(visible == (frusta[f].IsInsideFast(boxes[i]) != OUTSIDE));
+			visibleCount += visible ? 1 : 0;
+		}
+
+		REQUIRE(visibleCount > 0);
+		REQUIRE(visibleCount < count);
+
+		// Bits past the last box stay clear
+		REQUIRE((visibility[f * words + words - 1] >> (count % 32)) == 0);
+	}
+
+	list.Clear();
+	REQUIRE(list.Size() == 0);
+	CullBoxes(frusta, 3, list, nullptr);
+}
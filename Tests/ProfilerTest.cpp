@@ -0,0 +1,461 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include <Core/JobSystem.h>
+#include <Core/Profiler.h>
+#include <Core/OS/FileSystem.h>
+#include <Utilities/FrameTimeHistory.h>
+
+#include <json.hpp>
+
+namespace
+{
+	const char* const OuterName = "ProfilerTest::Outer";
+	const char* const InnerName = "ProfilerTest::Inner";
+	const char* const JobName = "ProfilerTest::Job";
+	const char* const WaitName = "ProfilerTest::Wait";
+
+	const Lumos::ProfilerCallNode* FindNode(const Lumos::ProfilerCallNode& node, const char* name)
+	{
+		// Compared by content, names recorded by other translation units may not share the literal
+		for (auto& child : node.children)
+		{
+			if (child.name && strcmp(child.name, name) == 0)
+				return &child;
+			if (auto found = FindNode(child, name))
+				return found;
+		}
+		return nullptr;
+	}
+
+	uint64_t CallCount(const Lumos::ProfilerReport& report, const char* name)
+	{
+		for (auto& action : report.actions)
+			if (action.name == name)
+				return action.calls;
+		return 0;
+	}
+
+	// The previous marker (heap allocated record, mutex and two map updates per scope), kept as a baseline
+	class LegacyProfiler
+	{
+	public:
+		struct Record
+		{
+			Record(LegacyProfiler& profiler, const char* name) : profiler(profiler), name(name), start(Lumos::Profiler::Now()) {}
+			~Record() { profiler.Save(name, static_cast<float>(Lumos::Profiler::Now() - start) / 1000000.0f); }
+
+			LegacyProfiler& profiler;
+			const char* name;
+			int64_t start;
+		};
+
+		void Save(const char* name, float elapsed)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_Elapsed[name] += elapsed;
+			++m_Calls[name];
+		}
+
+	private:
+		std::mutex m_Mutex;
+		std::unordered_map<const char*, float> m_Elapsed;
+		std::unordered_map<const char*, uint64_t> m_Calls;
+	};
+}
+
+TEST_CASE("Profiler Events", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	Profiler* profiler = Profiler::Instance();
+	const bool wasEnabled = profiler->IsEnabled();
+	profiler->Enable();
+	profiler->Flush();
+	profiler->ClearHistory();
+
+	{
+		LUMOS_PROFILE_BLOCK(OuterName);
+		for (int i = 0; i < 10; ++i)
+		{
+			LUMOS_PROFILE_BLOCK(InnerName);
+		}
+	}
+
+	System::JobSystem::Dispatch(64, 1, [](JobDispatchArgs)
+	{
+		LUMOS_PROFILE_BLOCK(JobName);
+	});
+	System::JobSystem::Wait();
+
+	// Events from every thread are aggregated by the main thread once per frame
+	profiler->Update(0.0f);
+	ProfilerReport report = profiler->GenerateReport();
+	REQUIRE(CallCount(report, OuterName) == 1);
+	REQUIRE(CallCount(report, InnerName) == 10);
+	REQUIRE(CallCount(report, JobName) == 64);
+
+	// Nothing is recorded while disabled
+	profiler->Disable();
+	{
+		LUMOS_PROFILE_BLOCK(OuterName);
+	}
+	profiler->Update(0.0f);
+	REQUIRE(CallCount(profiler->GenerateReport(), OuterName) == 1);
+	REQUIRE(profiler->GetDroppedEventCount() == 0);
+
+	profiler->ClearHistory();
+	if (wasEnabled)
+		profiler->Enable();
+}
+
+TEST_CASE("Profiler Marker Overhead", "[LumosEngine][!benchmark]")
+{
+	using namespace Lumos;
+
+	const int markerCount = 1000;
+	Profiler* profiler = Profiler::Instance();
+	const bool wasEnabled = profiler->IsEnabled();
+
+	profiler->Disable();
+	BENCHMARK("Disabled: 1000 markers")
+	{
+		for (int i = 0; i < markerCount; ++i)
+		{
+			LUMOS_PROFILE_BLOCK(InnerName);
+		}
+		return markerCount;
+	};
+
+	// Includes the main thread's per frame aggregation of the events
+	profiler->Enable();
+	BENCHMARK("Enabled: 1000 markers")
+	{
+		for (int i = 0; i < markerCount; ++i)
+		{
+			LUMOS_PROFILE_BLOCK(InnerName);
+		}
+		profiler->Flush();
+		return markerCount;
+	};
+
+	BENCHMARK("Enabled: 1000 markers on every worker")
+	{
+		System::JobSystem::Dispatch(System::JobSystem::GetThreadCount(), 1, [](JobDispatchArgs)
+		{
+			for (int i = 0; i < markerCount; ++i)
+			{
+				LUMOS_PROFILE_BLOCK(InnerName);
+			}
+		});
+		System::JobSystem::Wait();
+		profiler->Flush();
+		return markerCount;
+	};
+
+	LegacyProfiler legacy;
+	BENCHMARK("Legacy: 1000 markers")
+	{
+		for (int i = 0; i < markerCount; ++i)
+		{
+			auto record = std::make_unique<LegacyProfiler::Record>(legacy, InnerName);
+		}
+		return markerCount;
+	};
+
+	BENCHMARK("Legacy: 1000 markers on every worker")
+	{
+		System::JobSystem::Dispatch(System::JobSystem::GetThreadCount(), 1, [&legacy](JobDispatchArgs)
+		{
+			for (int i = 0; i < markerCount; ++i)
+			{
+				auto record = std::make_unique<LegacyProfiler::Record>(legacy, InnerName);
+			}
+		});
+		System::JobSystem::Wait();
+		return markerCount;
+	};
+
+	profiler->ClearHistory();
+	if (!wasEnabled)
+		profiler->Disable();
+}
+
+TEST_CASE("Profiler Chrome Trace", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	Profiler* profiler = Profiler::Instance();
+	const bool wasEnabled = profiler->IsEnabled();
+	profiler->Disable();
+	profiler->Flush();
+
+	// Not part of the capture
+	Profiler::Record(OuterName, Profiler::Now() - 1000, Profiler::Now(), 0);
+
+	const String path = "profiler_test_capture.json";
+	profiler->CaptureFrames(2, path);
+	REQUIRE(profiler->IsEnabled());
+
+	for (int frame = 0; frame < 2; ++frame)
+	{
+		{
+			LUMOS_PROFILE_BLOCK(OuterName);
+			{
+				LUMOS_PROFILE_BLOCK(InnerName);
+			}
+		}
+
+		System::JobSystem::Dispatch(8, 1, [](JobDispatchArgs)
+		{
+			LUMOS_PROFILE_BLOCK(JobName);
+		});
+		System::JobSystem::Wait();
+
+		REQUIRE(profiler->IsCapturing());
+		profiler->Update(0.0f);
+	}
+
+	// Written out once the frames are done, and the previous enabled state is restored
+	REQUIRE_FALSE(profiler->IsCapturing());
+	REQUIRE_FALSE(profiler->IsEnabled());
+	REQUIRE(FileSystem::FileExists(path));
+
+	auto trace = nlohmann::json::parse(FileSystem::ReadTextFile(path));
+	std::map<String, int> completeEvents;
+	int frameMarkers = 0;
+	int threadNames = 0;
+	for (auto& event : trace["traceEvents"])
+	{
+		const String phase = event["ph"];
+		if (phase == "X")
+		{
+			REQUIRE(event["dur"].get<double>() >= 0.0);
+			REQUIRE(event["ts"].get<double>() >= 0.0);
+			++completeEvents[event["name"].get<String>()];
+		}
+		else if (phase == "i")
+			++frameMarkers;
+		else if (phase == "M")
+			++threadNames;
+	}
+
+	REQUIRE(completeEvents[OuterName] == 2);
+	REQUIRE(completeEvents[InnerName] == 2);
+	REQUIRE(completeEvents[JobName] == 16);
+	REQUIRE(frameMarkers == 2);
+	REQUIRE(threadNames >= 1);
+
+	std::remove(path.c_str());
+	profiler->ClearHistory();
+	if (wasEnabled)
+		profiler->Enable();
+}
+
+TEST_CASE("Profiler Call Tree", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	Profiler* profiler = Profiler::Instance();
+	const bool wasEnabled = profiler->IsEnabled();
+	profiler->Enable();
+	profiler->SetCallTreeWindow(3);
+
+	REQUIRE(ProfilerRecord::Current() == nullptr);
+
+	for (int frame = 0; frame < 5; ++frame)
+	{
+		{
+			LUMOS_PROFILE_BLOCK(OuterName);
+			for (int i = 0; i < 4; ++i)
+			{
+				LUMOS_PROFILE_BLOCK(InnerName);
+				REQUIRE(ProfilerRecord::Current()->Depth() == 1);
+				REQUIRE(strcmp(ProfilerRecord::Current()->Parent()->Name(), OuterName) == 0);
+			}
+		}
+
+		// Workers start their own stack, jobs run by the waiting main thread nest under its open scope
+		{
+			LUMOS_PROFILE_BLOCK(JobName);
+			System::JobSystem::Dispatch(16, 1, [](JobDispatchArgs)
+			{
+				LUMOS_PROFILE_BLOCK(InnerName);
+			});
+			System::JobSystem::Wait();
+		}
+
+		profiler->Update(0.0f);
+	}
+
+	// Only the last three frames are kept
+	const ProfilerCallNode& tree = profiler->GetCallTree();
+	REQUIRE(profiler->GetCallTreeFrameCount() == 3);
+
+	const ProfilerCallNode* outer = FindNode(tree, OuterName);
+	REQUIRE(outer != nullptr);
+	REQUIRE(outer->calls == 3);
+	REQUIRE(outer->children.size() == 1);
+
+	const ProfilerCallNode& inner = outer->children[0];
+	REQUIRE(inner.name == InnerName);
+	REQUIRE(inner.calls == 12);
+	REQUIRE(inner.inclusive <= outer->inclusive);
+	REQUIRE(outer->exclusive == Approx(outer->inclusive - inner.inclusive));
+
+	uint64_t jobCalls = 0;
+	for (auto& thread : tree.children)
+	{
+		for (auto& scope : thread.children)
+		{
+			if (scope.name == InnerName)
+				jobCalls += scope.calls;
+			// Jobs the main thread ran while waiting are nested in its helping scope
+			if (scope.name == JobName)
+				if (auto helping = FindNode(scope, "JobSystem::Wait Helping"))
+					for (auto& child : helping->children)
+						jobCalls += child.calls;
+		}
+	}
+	REQUIRE(jobCalls == 48);
+
+	profiler->SetCallTreeWindow(60);
+	profiler->ClearHistory();
+	if (!wasEnabled)
+		profiler->Disable();
+}
+
+TEST_CASE("Profiler Wait Scopes", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	Profiler* profiler = Profiler::Instance();
+	const bool wasEnabled = profiler->IsEnabled();
+	profiler->Enable();
+	profiler->ClearHistory();
+
+	{
+		LUMOS_PROFILE_BLOCK(WaitName);
+		System::JobSystem::Context ctx;
+
+		// One job more than there are workers, none finishes before all have started, so the waiting thread runs one
+		const uint32_t jobCount = System::JobSystem::GetThreadCount() + 1;
+		std::atomic<uint32_t> started { 0 };
+		System::JobSystem::Dispatch(ctx, jobCount, 1, [&](JobDispatchArgs)
+		{
+			started.fetch_add(1);
+			while (started.load() < jobCount)
+				std::this_thread::yield();
+		});
+		System::JobSystem::WaitFor(ctx);
+
+		// A job already running on a worker leaves the waiting thread nothing to do
+		std::atomic<bool> running { false };
+		System::JobSystem::Execute(ctx, [&]()
+		{
+			running = true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		});
+		while (!running)
+			std::this_thread::yield();
+		System::JobSystem::WaitFor(ctx);
+	}
+
+	profiler->Update(0.0f);
+
+	const ProfilerCallNode* wait = FindNode(profiler->GetCallTree(), WaitName);
+	REQUIRE(wait != nullptr);
+
+	const ProfilerCallNode* helping = FindNode(*wait, "JobSystem::Wait Helping");
+	REQUIRE(helping != nullptr);
+	REQUIRE(helping->calls >= 1);
+
+	const ProfilerCallNode* idle = FindNode(*wait, "JobSystem::Wait Idle");
+	REQUIRE(idle != nullptr);
+	REQUIRE(idle->calls >= 1);
+	REQUIRE(helping->inclusive + idle->inclusive <= wait->inclusive);
+
+	profiler->ClearHistory();
+	if (!wasEnabled)
+		profiler->Disable();
+}
+
+TEST_CASE("Frame Time History", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	FrameTimeHistory history(100);
+	REQUIRE(history.CalculateStats().frames == 0);
+
+	// Overwritten by the 100 frames after it
+	history.Add(1000.0f);
+
+	for (int i = 1; i <= 100; ++i)
+		history.Add(static_cast<float>(i));
+
+	FrameTimeStats stats = history.CalculateStats();
+	REQUIRE(stats.frames == 100);
+	REQUIRE(stats.p50 == 50.0f);
+	REQUIRE(stats.p95 == 95.0f);
+	REQUIRE(stats.p99 == 99.0f);
+	REQUIRE(stats.max == 100.0f);
+	REQUIRE(stats.average == Approx(50.5f));
+	REQUIRE(history.Get(0) == 1.0f);
+	REQUIRE(history.GetLast() == 100.0f);
+
+	history.SetCapacity(10);
+	stats = history.CalculateStats();
+	REQUIRE(stats.frames == 10);
+	REQUIRE(history.Get(0) == 91.0f);
+	REQUIRE(stats.max == 100.0f);
+}
+
+TEST_CASE("Profiler Spike Capture", "[LumosEngine]")
+{
+	using namespace Lumos;
+
+	Profiler* profiler = Profiler::Instance();
+	const bool wasEnabled = profiler->IsEnabled();
+	profiler->Enable();
+	profiler->Update(0.0f);
+	profiler->ClearSpikes();
+	profiler->SetSpikeThreshold(20.0f, 2);
+
+	for (int frame = 0; frame < 6; ++frame)
+	{
+		{
+			LUMOS_PROFILE_BLOCK(OuterName);
+			// Every other frame stalls past the threshold
+			if (frame % 2 == 1)
+			{
+				LUMOS_PROFILE_BLOCK(InnerName);
+				std::this_thread::sleep_for(std::chrono::milliseconds(30));
+			}
+		}
+		profiler->Update(0.0f);
+	}
+
+	// Only the newest two spikes are kept, each with the events of its own frame
+	const auto& spikes = profiler->GetSpikes();
+	REQUIRE(spikes.size() == 2);
+	REQUIRE(spikes[1].frame == spikes[0].frame + 2);
+	for (auto& spike : spikes)
+	{
+		REQUIRE(spike.frameTime > 20.0f);
+		REQUIRE(spike.trace.events.size() == 2);
+		REQUIRE(spike.trace.frameEnds.size() == 1);
+	}
+
+	auto trace = nlohmann::json::parse(Profiler::ExportChromeTrace(spikes[0].trace));
+	int innerEvents = 0;
+	for (auto& event : trace["traceEvents"])
+		if (event["ph"] == "X" && event["name"] == InnerName)
+			++innerEvents;
+	REQUIRE(innerEvents == 1);
+
+	profiler->SetSpikeThreshold(0.0f);
+	profiler->ClearSpikes();
+	profiler->ClearHistory();
+	if (!wasEnabled)
+		profiler->Disable();
+}
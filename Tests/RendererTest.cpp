@@ -0,0 +1,186 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+
+#ifdef LUMOS_RENDER_API_NONE
+#include <Graphics/API/Pipeline.h>
+#include <Graphics/API/DescriptorSet.h>
+#include <Graphics/API/UniformBuffer.h>
+#include <Platform/Null/NullRenderer.h>
+#include <Core/Profiler.h>
+
+using namespace Lumos::Graphics;
+
+TEST_CASE("Null Renderer", "[LumosEngine]")
+{
+	GraphicsContext::SetRenderAPI(RenderAPI::NONE);
+	Renderer::Init(640, 480);
+	NullRenderer::ResetStats();
+
+	Shader* shader = Shader::CreateFromFile("Simple", "/CoreShaders/");
+
+	PipelineInfo pipelineInfo{};
+	pipelineInfo.shader = shader;
+	Pipeline* pipeline = Pipeline::Create(pipelineInfo);
+
+	float vertices[64] = {};
+	VertexBuffer* vertexBuffer = VertexBuffer::Create(BufferUsage::DYNAMIC);
+	vertexBuffer->SetData(sizeof(vertices), vertices);
+
+	u32 indices[6] = { 0, 1, 2, 2, 3, 0 };
+	IndexBuffer* indexBuffer = IndexBuffer::Create(indices, 6);
+
+	u8 uniforms[64] = {};
+	UniformBuffer* uniformBuffer = UniformBuffer::Create();
+	uniformBuffer->SetData(sizeof(uniforms), uniforms);
+
+	u8 pixels[16] = {};
+	Texture2D* texture = Texture2D::CreateFromSource(2, 2, pixels);
+
+	DescriptorInfo descriptorInfo{};
+	descriptorInfo.pipeline = pipeline;
+	descriptorInfo.shader = shader;
+	DescriptorSet* descriptorSet = DescriptorSet::Create(descriptorInfo);
+
+	BufferInfo bufferInfo;
+	bufferInfo.buffer = uniformBuffer;
+	bufferInfo.offset = 0;
+	bufferInfo.size = sizeof(uniforms);
+	bufferInfo.binding = 0;
+	bufferInfo.type = DescriptorType::UNIFORM_BUFFER;
+	bufferInfo.shaderType = ShaderType::VERTEX;
+	bufferInfo.systemUniforms = true;
+
+	ImageInfo imageInfo;
+	imageInfo.texture = { texture };
+	imageInfo.binding = 0;
+	imageInfo.name = "u_Texture";
+	imageInfo.type = TextureType::COLOUR;
+
+	std::vector<ImageInfo> imageInfos = { imageInfo };
+	std::vector<BufferInfo> bufferInfos = { bufferInfo };
+	descriptorSet->Update(imageInfos, bufferInfos);
+
+	std::vector<DescriptorSet*> descriptorSets = { descriptorSet };
+
+	auto drawFrame = [&]()
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			pipeline->SetActive(nullptr);
+			vertexBuffer->Bind();
+			indexBuffer->Bind(nullptr);
+			Renderer::BindDescriptorSets(pipeline, nullptr, 0, descriptorSets);
+			Renderer::DrawIndexed(nullptr, DrawType::TRIANGLE, indexBuffer->GetCount());
+		}
+		Renderer::Present();
+	};
+
+	const u64 creationBytes = sizeof(vertices) + sizeof(indices) + sizeof(uniforms) + sizeof(pixels);
+
+	drawFrame();
+
+	const NullFrameStats& first = NullRenderer::GetLastFrameStats();
+	REQUIRE(first.drawCalls == 2);
+	REQUIRE(first.indices == 12);
+	REQUIRE(first.descriptorSetBinds == 2);
+
+	// Rebinding what is already bound doesn't count
+	REQUIRE(first.pipelineChanges == 1);
+	REQUIRE(first.shaderChanges == 1);
+	REQUIRE(first.vertexBufferChanges == 1);
+	REQUIRE(first.indexBufferChanges == 1);
+	REQUIRE(first.textureChanges == 1);
+
+	// Buffer creation plus the uniforms handed to the shader on each descriptor set bind
+	REQUIRE(first.bytesUploaded == creationBytes + 2 * sizeof(uniforms));
+	REQUIRE(NullRenderer::GetFrameStats().drawCalls == 0);
+
+	drawFrame();
+
+	const NullFrameStats& second = NullRenderer::GetLastFrameStats();
+	REQUIRE(second.drawCalls == 2);
+	REQUIRE(second.pipelineChanges == 0);
+	REQUIRE(second.textureChanges == 0);
+	REQUIRE(second.GetStateChanges() == second.descriptorSetBinds);
+	REQUIRE(second.bytesUploaded == 2 * sizeof(uniforms));
+	REQUIRE(NullRenderer::GetTotalBytesUploaded() == creationBytes + 4 * sizeof(uniforms));
+
+	REQUIRE(NullRenderer::GetBoundState().pipeline == pipeline);
+	REQUIRE(NullRenderer::GetBoundState().textures[0] == texture);
+
+	delete descriptorSet;
+	delete texture;
+	delete uniformBuffer;
+	delete indexBuffer;
+	delete vertexBuffer;
+	delete pipeline;
+	delete shader;
+
+	REQUIRE(NullRenderer::GetBoundState().pipeline == nullptr);
+	REQUIRE(NullRenderer::GetBoundState().textures[0] == nullptr);
+
+	Renderer::Release();
+}
+
+TEST_CASE("Render Stats", "[LumosEngine]")
+{
+	GraphicsContext::SetRenderAPI(RenderAPI::NONE);
+	Renderer::Init(640, 480);
+	Renderer::ResetRenderStats();
+
+	Shader* shader = Shader::CreateFromFile("Simple", "/CoreShaders/");
+
+	PipelineInfo pipelineInfo{};
+	pipelineInfo.shader = shader;
+	Pipeline* pipeline = Pipeline::Create(pipelineInfo);
+
+	DescriptorInfo descriptorInfo{};
+	descriptorInfo.pipeline = pipeline;
+	descriptorInfo.shader = shader;
+	DescriptorSet* descriptorSet = DescriptorSet::Create(descriptorInfo);
+	std::vector<DescriptorSet*> descriptorSets = { descriptorSet };
+
+	u8 uniforms[256] = {};
+	UniformBuffer* uniformBuffer = UniformBuffer::Create();
+	uniformBuffer->SetData(64, uniforms);
+	uniformBuffer->SetDynamicData(sizeof(uniforms), 64, uniforms);
+
+	Renderer::BindDescriptorSets(pipeline, nullptr, 0, descriptorSets);
+	Renderer::DrawIndexed(nullptr, DrawType::TRIANGLE, 36);
+	Renderer::Draw(nullptr, DrawType::LINES, 10);
+
+	Renderer::RecordCulling(true);
+	Renderer::RecordCulling(false);
+	Renderer::RecordCulling(false);
+
+	REQUIRE(Renderer::GetCurrentRenderStats().drawCalls == 2);
+	REQUIRE(Renderer::GetRenderStats().drawCalls == 0);
+
+	Renderer::Present();
+
+	const RenderStats& stats = Renderer::GetRenderStats();
+	REQUIRE(stats.drawCalls == 2);
+	REQUIRE(stats.indices == 46);
+	REQUIRE(stats.triangles == 12);
+	REQUIRE(stats.visibleObjects == 1);
+	REQUIRE(stats.culledObjects == 2);
+	REQUIRE(stats.descriptorSetBinds == 1);
+	REQUIRE(stats.uniformBytesUploaded == 64 + sizeof(uniforms));
+	REQUIRE(Renderer::GetCurrentRenderStats().drawCalls == 0);
+
+	// The last frame is also published as profiler counters
+	double drawCallCounter = -1.0;
+	for (auto& counter : Lumos::Profiler::Instance()->GetCounters())
+		if (strcmp(counter.name, "Render Draw Calls") == 0)
+			drawCallCounter = counter.value;
+	REQUIRE(drawCallCounter == 2.0);
+
+	delete uniformBuffer;
+	delete descriptorSet;
+	delete pipeline;
+	delete shader;
+
+	Renderer::Release();
+}
+#endif
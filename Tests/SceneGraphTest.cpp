@@ -0,0 +1,408 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include <App/SceneGraph.h>
+#include <Maths/Transform.h>
+#include <Maths/TransformStore.h>
+
+namespace
+{
+	using namespace Lumos;
+
+	entt::entity CreateNode(entt::registry& registry, entt::entity parent, const Maths::Vector3& position)
+	{
+		auto entity = registry.create();
+		registry.assign<Maths::Transform>(entity, position);
+		if (parent != entt::null)
+			registry.assign<Hierarchy>(entity, parent);
+		return entity;
+	}
+
+	Maths::Vector3 WorldPosition(entt::registry& registry, entt::entity entity)
+	{
+		return registry.get<Maths::Transform>(entity).GetWorldMatrix().Translation();
+	}
+
+	// Every node's parent sits in a shallower level and each level range holds only its own depth
+	bool LayoutIsOrdered(entt::registry& registry)
+	{
+		auto& layout = registry.ctx<HierarchyLayout>();
+		auto& nodes = layout.GetNodes();
+
+		for (u32 level = 0; level < layout.GetLevelCount(); level++)
+		{
+			for (u32 i = layout.GetLevelBegin(level); i < layout.GetLevelEnd(level); i++)
+			{
+				if (registry.get<Hierarchy>(nodes[i].entity)._index != i)
+					return false;
+				if (nodes[i].parent != HierarchyLayout::Invalid && nodes[i].parent >= layout.GetLevelBegin(level))
+					return false;
+				if (nodes[i].parent != HierarchyLayout::Invalid && nodes[nodes[i].parent].entity != registry.get<Hierarchy>(nodes[i].entity).parent())
+					return false;
+			}
+		}
+
+		return layout.GetLevelCount() == 0 ? nodes.empty() : layout.GetLevelEnd(layout.GetLevelCount() - 1) == nodes.size();
+	}
+
+	bool AnyDirty(entt::registry& registry)
+	{
+		bool dirty = false;
+		registry.view<Maths::Transform>().each([&dirty](auto entity, Maths::Transform& transform) { dirty |= transform.IsDirty(); });
+		return dirty;
+	}
+}
+
+TEST_CASE("SceneGraph Dirty Propagation", "[LumosEngine]")
+{
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	auto root = CreateNode(registry, entt::null, Maths::Vector3(1.0f, 0.0f, 0.0f));
+	auto child = CreateNode(registry, root, Maths::Vector3(0.0f, 2.0f, 0.0f));
+	auto grandChild = CreateNode(registry, child, Maths::Vector3(0.0f, 0.0f, 3.0f));
+	auto otherRoot = CreateNode(registry, entt::null, Maths::Vector3(-5.0f, 0.0f, 0.0f));
+
+	REQUIRE(AnyDirty(registry));
+	sceneGraph.Update(registry);
+	REQUIRE_FALSE(AnyDirty(registry));
+
+	REQUIRE(WorldPosition(registry, root) == Maths::Vector3(1.0f, 0.0f, 0.0f));
+	REQUIRE(WorldPosition(registry, child) == Maths::Vector3(1.0f, 2.0f, 0.0f));
+	REQUIRE(WorldPosition(registry, grandChild) == Maths::Vector3(1.0f, 2.0f, 3.0f));
+	REQUIRE(WorldPosition(registry, otherRoot) == Maths::Vector3(-5.0f, 0.0f, 0.0f));
+
+	// Moving a node updates it and everything under it
+	registry.get<Maths::Transform>(child).SetLocalPosition(Maths::Vector3(0.0f, 4.0f, 0.0f));
+	REQUIRE(registry.get<Maths::Transform>(child).IsDirty());
+	REQUIRE_FALSE(registry.get<Maths::Transform>(grandChild).IsDirty());
+
+	sceneGraph.Update(registry);
+	REQUIRE_FALSE(AnyDirty(registry));
+	REQUIRE(WorldPosition(registry, child) == Maths::Vector3(1.0f, 4.0f, 0.0f));
+	REQUIRE(WorldPosition(registry, grandChild) == Maths::Vector3(1.0f, 4.0f, 3.0f));
+
+	// A changed parent and child in the same frame both end up correct
+	registry.get<Maths::Transform>(root).SetLocalPosition(Maths::Vector3(2.0f, 0.0f, 0.0f));
+	registry.get<Maths::Transform>(grandChild).SetLocalPosition(Maths::Vector3(0.0f, 0.0f, 1.0f));
+	sceneGraph.Update(registry);
+	REQUIRE(WorldPosition(registry, child) == Maths::Vector3(2.0f, 4.0f, 0.0f));
+	REQUIRE(WorldPosition(registry, grandChild) == Maths::Vector3(2.0f, 4.0f, 1.0f));
+
+	// Reparenting keeps the local transform and picks up the new parent
+	Hierarchy::Reparent(grandChild, otherRoot, registry, registry.get<Hierarchy>(grandChild));
+	REQUIRE(registry.get<Maths::Transform>(grandChild).IsDirty());
+	sceneGraph.Update(registry);
+	REQUIRE(WorldPosition(registry, grandChild) == Maths::Vector3(-5.0f, 0.0f, 1.0f));
+
+	// Nothing changed, nothing is touched
+	sceneGraph.Update(registry);
+	REQUIRE_FALSE(AnyDirty(registry));
+	REQUIRE(WorldPosition(registry, grandChild) == Maths::Vector3(-5.0f, 0.0f, 1.0f));
+}
+
+TEST_CASE("SceneGraph Hierarchy Layout", "[LumosEngine]")
+{
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	// Parents always have a lower index than their children, so reparenting never makes a cycle
+	std::vector<entt::entity> nodes;
+	for (u32 i = 0; i < 64; i++)
+		nodes.push_back(CreateNode(registry, i == 0 ? entt::null : nodes[(i * 7 + 3) % i], Maths::Vector3(1.0f, 0.0f, 0.0f)));
+
+	REQUIRE(LayoutIsOrdered(registry));
+	REQUIRE(registry.ctx<HierarchyLayout>().GetNodes().size() == nodes.size());
+
+	auto& first = registry.get<Hierarchy>(nodes[0]);
+	entt::entity last = first.first();
+	while (registry.get<Hierarchy>(last).next() != entt::null)
+		last = registry.get<Hierarchy>(last).next();
+	REQUIRE(first.last() == last);
+
+	for (u32 i = 1; i < 64; i += 3)
+	{
+		Hierarchy::Reparent(nodes[i], i % 2 ? entt::null : nodes[i / 2], registry, registry.get<Hierarchy>(nodes[i]));
+		REQUIRE(LayoutIsOrdered(registry));
+	}
+
+	registry.destroy(nodes[5]);
+	registry.remove<Hierarchy>(nodes[3]);
+	REQUIRE(LayoutIsOrdered(registry));
+
+	// World positions match a walk up the parent chain. Children of nodes[3] still follow its Transform.
+	auto checkWorldPositions = [&](float detachedOffset)
+	{
+		for (auto entity : nodes)
+		{
+			if (!registry.valid(entity))
+				continue;
+
+			float depth = 1.0f;
+			auto current = entity;
+			auto hierarchy = registry.try_get<Hierarchy>(entity);
+			while (hierarchy && hierarchy->parent() != entt::null && registry.valid(hierarchy->parent()))
+			{
+				depth += 1.0f;
+				current = hierarchy->parent();
+				hierarchy = registry.try_get<Hierarchy>(current);
+			}
+
+			const float offset = current == nodes[3] ? detachedOffset : 0.0f;
+			REQUIRE(WorldPosition(registry, entity) == Maths::Vector3(depth + offset, 0.0f, 0.0f));
+		}
+	};
+
+	REQUIRE_FALSE(registry.has<Hierarchy>(nodes[3]));
+	u32 detachedChildren = 0;
+	registry.view<Hierarchy>().each([&](auto entity, Hierarchy& hierarchy) { detachedChildren += hierarchy.parent() == nodes[3] ? 1 : 0; });
+	REQUIRE(detachedChildren > 0);
+
+	sceneGraph.Update(registry);
+	checkWorldPositions(0.0f);
+
+	registry.get<Maths::Transform>(nodes[3]).SetLocalPosition(Maths::Vector3(3.0f, 0.0f, 0.0f));
+	sceneGraph.Update(registry);
+	checkWorldPositions(2.0f);
+}
+
+TEST_CASE("SceneGraph Init Existing Hierarchy", "[LumosEngine]")
+{
+	// Hierarchies assigned before the scene graph is set up, no child lists and no layout yet
+	entt::registry registry;
+
+	auto root = CreateNode(registry, entt::null, Maths::Vector3(1.0f, 0.0f, 0.0f));
+	registry.assign<Hierarchy>(root);
+	auto child = CreateNode(registry, root, Maths::Vector3(2.0f, 0.0f, 0.0f));
+	auto grandChild = CreateNode(registry, child, Maths::Vector3(4.0f, 0.0f, 0.0f));
+
+	std::vector<entt::entity> wide;
+	for (u32 i = 0; i < 100; i++)
+		wide.push_back(CreateNode(registry, i == 0 ? root : wide[i / 2], Maths::Vector3(1.0f, 0.0f, 0.0f)));
+
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+	REQUIRE(registry.ctx<HierarchyLayout>().GetNodes().size() == 103);
+	u32 rootChildren = 0;
+	for (auto entity = registry.get<Hierarchy>(root).first(); entity != entt::null; entity = registry.get<Hierarchy>(entity).next())
+		rootChildren++;
+	REQUIRE(rootChildren == 2);
+	REQUIRE(LayoutIsOrdered(registry));
+
+	sceneGraph.Update(registry);
+	REQUIRE(WorldPosition(registry, child) == Maths::Vector3(3.0f, 0.0f, 0.0f));
+	REQUIRE(WorldPosition(registry, grandChild) == Maths::Vector3(7.0f, 0.0f, 0.0f));
+
+	// A second Init keeps the layout the live components point into
+	auto& layout = registry.ctx<HierarchyLayout>();
+	sceneGraph.Init(registry);
+	REQUIRE(&registry.ctx<HierarchyLayout>() == &layout);
+	REQUIRE(layout.GetNodes().size() == 103);
+	REQUIRE(LayoutIsOrdered(registry));
+
+	registry.get<Maths::Transform>(root).SetLocalPosition(Maths::Vector3(2.0f, 0.0f, 0.0f));
+	CreateNode(registry, grandChild, Maths::Vector3(8.0f, 0.0f, 0.0f));
+	REQUIRE(LayoutIsOrdered(registry));
+	sceneGraph.Update(registry);
+	REQUIRE(WorldPosition(registry, grandChild) == Maths::Vector3(8.0f, 0.0f, 0.0f));
+	// wide[99] sits under 8 nodes of the wide tree
+	REQUIRE(WorldPosition(registry, wide[99]) == Maths::Vector3(2.0f + 8.0f, 0.0f, 0.0f));
+}
+
+TEST_CASE("SceneGraph Update", "[LumosEngine][!benchmark]")
+{
+	// 10k roots with 9 descendants each, a handful of nodes move per frame
+	const u32 rootCount = 10000;
+	const u32 movingPerFrame = 8;
+
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	std::vector<entt::entity> nodes;
+	for (u32 i = 0; i < rootCount; i++)
+	{
+		auto root = CreateNode(registry, entt::null, Maths::Vector3(static_cast<float>(i), 0.0f, 0.0f));
+		auto branch = CreateNode(registry, root, Maths::Vector3(0.0f, 1.0f, 0.0f));
+		nodes.push_back(root);
+		nodes.push_back(branch);
+		for (u32 j = 0; j < 8; j++)
+			nodes.push_back(CreateNode(registry, j < 4 ? branch : root, Maths::Vector3(0.0f, 0.0f, static_cast<float>(j))));
+	}
+
+	REQUIRE(nodes.size() == 100000);
+	sceneGraph.Update(registry);
+
+	u32 frame = 0;
+	BENCHMARK("100k nodes, 8 moving")
+	{
+		for (u32 i = 0; i < movingPerFrame; i++)
+		{
+			auto& transform = registry.get<Maths::Transform>(nodes[(frame * 7919 + i * 104729) % nodes.size()]);
+			transform.SetLocalPosition(transform.GetLocalPosition() + Maths::Vector3(0.0f, 0.01f, 0.0f));
+		}
+		frame++;
+
+		sceneGraph.Update(registry);
+		return frame;
+	};
+
+	BENCHMARK("100k nodes, all moving")
+	{
+		registry.view<Maths::Transform>().each([](auto entity, Maths::Transform& transform) { transform.SetHasUpdated(true); });
+		sceneGraph.Update(registry);
+		return registry.size();
+	};
+}
+
+TEST_CASE("SceneGraph Wide Hierarchy", "[LumosEngine][!benchmark]")
+{
+	// Shaped like an imported model, one root with 10k meshes of 4 submeshes each
+	const u32 meshCount = 10000;
+
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	auto root = CreateNode(registry, entt::null, Maths::Vector3(0.0f, 0.0f, 0.0f));
+	for (u32 i = 0; i < meshCount; i++)
+	{
+		auto mesh = CreateNode(registry, root, Maths::Vector3(static_cast<float>(i), 0.0f, 0.0f));
+		for (u32 j = 0; j < 4; j++)
+			CreateNode(registry, mesh, Maths::Vector3(0.0f, static_cast<float>(j), 0.0f));
+	}
+
+	REQUIRE(registry.ctx<HierarchyLayout>().GetLevelCount() == 3);
+	sceneGraph.Update(registry);
+
+	BENCHMARK("50k nodes, root moving")
+	{
+		auto& transform = registry.get<Maths::Transform>(root);
+		transform.SetLocalPosition(transform.GetLocalPosition() + Maths::Vector3(0.0f, 0.01f, 0.0f));
+		sceneGraph.Update(registry);
+		return registry.size();
+	};
+
+	BENCHMARK("50k nodes, all moving")
+	{
+		registry.view<Maths::Transform>().each([](auto entity, Maths::Transform& transform) { transform.SetHasUpdated(true); });
+		sceneGraph.Update(registry);
+		return registry.size();
+	};
+}
+
+TEST_CASE("SceneGraph SoA Transforms", "[LumosEngine]")
+{
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	// An entity has one kind of transform, each SoA entity gets a Transform twin to compare against
+	std::vector<entt::entity> entities;
+	std::vector<entt::entity> references;
+	for (u32 i = 0; i < 8; i++)
+	{
+		auto entity = registry.create();
+		auto reference = registry.create();
+		auto& bulk = registry.assign<Maths::SoATransform>(entity);
+		auto& transform = registry.assign<Maths::Transform>(reference);
+
+		const auto position = Maths::Vector3(static_cast<float>(i), 1.0f, 2.0f);
+		const auto orientation = Maths::Quaternion::EulerAnglesToQuaternion(10.0f * i, 20.0f, 0.0f);
+		bulk.SetLocalPosition(position);
+		bulk.SetLocalOrientation(orientation);
+		bulk.SetLocalScale(Maths::Vector3(2.0f, 2.0f, 2.0f));
+		transform.SetLocalPosition(position);
+		transform.SetLocalOrientation(orientation);
+		transform.SetLocalScale(Maths::Vector3(2.0f, 2.0f, 2.0f));
+
+		entities.push_back(entity);
+		references.push_back(reference);
+	}
+
+	REQUIRE(registry.get<Maths::SoATransform>(entities[3]).IsDirty());
+	sceneGraph.Update(registry);
+
+	// Both layouts give the same world matrices
+	for (u32 i = 0; i < 8; i++)
+	{
+		auto& bulk = registry.get<Maths::SoATransform>(entities[i]);
+		REQUIRE_FALSE(bulk.IsDirty());
+		REQUIRE(bulk.GetWorldMatrix() == registry.get<Maths::Transform>(references[i]).GetWorldMatrix());
+		REQUIRE(bulk.GetLocalPosition() == registry.get<Maths::Transform>(references[i]).GetLocalPosition());
+	}
+
+	// Removing one moves the last transform into its slot
+	registry.destroy(entities[2]);
+	auto& store = registry.ctx<Maths::TransformStore>();
+	REQUIRE(store.Size() == 7);
+	REQUIRE(registry.get<Maths::SoATransform>(entities[7]).GetIndex() == 2);
+	REQUIRE(store.GetEntity(2) == entities[7]);
+	REQUIRE(registry.get<Maths::SoATransform>(entities[7]).GetLocalPosition() == Maths::Vector3(7.0f, 1.0f, 2.0f));
+
+	registry.get<Maths::SoATransform>(entities[7]).SetLocalPosition(Maths::Vector3(0.0f, 0.0f, 0.0f));
+	REQUIRE(registry.get<Maths::SoATransform>(entities[7]).GetWorldPosition() == Maths::Vector3(7.0f, 1.0f, 2.0f));
+	sceneGraph.Update(registry);
+	REQUIRE(registry.get<Maths::SoATransform>(entities[7]).GetWorldPosition() == Maths::Vector3(0.0f, 0.0f, 0.0f));
+
+	// Replacing the component keeps its slot
+	registry.replace<Maths::SoATransform>(entities[4]);
+	REQUIRE(registry.get<Maths::SoATransform>(entities[4]).GetIndex() == 4);
+	REQUIRE(registry.get<Maths::SoATransform>(entities[4]).GetLocalPosition() == Maths::Vector3(4.0f, 1.0f, 2.0f));
+
+	// Initialising again keeps the store the live components point into
+	sceneGraph.Init(registry);
+	REQUIRE(&registry.ctx<Maths::TransformStore>() == &store);
+	REQUIRE(store.Size() == 7);
+	REQUIRE(registry.get<Maths::SoATransform>(entities[4]).GetLocalPosition() == Maths::Vector3(4.0f, 1.0f, 2.0f));
+}
+
+TEST_CASE("SceneGraph SoA Write Back", "[LumosEngine][!benchmark]")
+{
+	// Physics style write-back of position and orientation, then the world matrix update
+	const u32 count = 100000;
+
+	entt::registry registry;
+	SceneGraph sceneGraph;
+	sceneGraph.Init(registry);
+
+	entt::registry bulkRegistry;
+	SceneGraph bulkSceneGraph;
+	bulkSceneGraph.Init(bulkRegistry);
+
+	for (u32 i = 0; i < count; i++)
+	{
+		registry.assign<Maths::Transform>(registry.create());
+		bulkRegistry.assign<Maths::SoATransform>(bulkRegistry.create());
+	}
+
+	sceneGraph.Update(registry);
+	bulkSceneGraph.Update(bulkRegistry);
+
+	float offset = 0.0f;
+	BENCHMARK("100k Transform")
+	{
+		offset += 0.01f;
+		registry.view<Maths::Transform>().each([offset](auto entity, Maths::Transform& transform)
+		{
+			transform.SetLocalPosition(Maths::Vector3(offset, 0.0f, 0.0f));
+			transform.SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(offset, 0.0f, 0.0f));
+		});
+		sceneGraph.Update(registry);
+		return offset;
+	};
+
+	BENCHMARK("100k SoATransform")
+	{
+		offset += 0.01f;
+		bulkRegistry.view<Maths::SoATransform>().each([offset](auto entity, Maths::SoATransform& transform)
+		{
+			transform.SetLocalPosition(Maths::Vector3(offset, 0.0f, 0.0f));
+			transform.SetLocalOrientation(Maths::Quaternion::EulerAnglesToQuaternion(offset, 0.0f, 0.0f));
+		});
+		bulkSceneGraph.Update(bulkRegistry);
+		return offset;
+	};
+}
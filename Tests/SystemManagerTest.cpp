@@ -0,0 +1,129 @@
+#include <catch.hpp>
+
+#include <LumosEngine.h>
+#include <ECS/SystemManager.h>
+
+#include <atomic>
+
+namespace
+{
+	using namespace Lumos;
+
+	struct ComponentA {};
+	struct ComponentB {};
+
+	// Records the order systems ran in, no component is ever touched
+	struct RunLog
+	{
+		std::atomic<u32> counter { 0 };
+	};
+
+	class TestSystem : public ISystem
+	{
+	public:
+		TestSystem(RunLog& log) : m_Log(log) {}
+
+		void OnInit() override {}
+		void OnUpdate(TimeStep* dt, Scene* scene) override { m_RunIndex = m_Log.counter.fetch_add(1); }
+		void OnImGui() override {}
+
+		u32 GetRunIndex() const { return m_RunIndex; }
+
+	protected:
+		RunLog& m_Log;
+		u32 m_RunIndex = ~0u;
+	};
+
+	class ReadsA : public TestSystem
+	{
+	public:
+		ReadsA(RunLog& log) : TestSystem(log) { Reads<ComponentA>(); }
+	};
+
+	class ReadsAOther : public TestSystem
+	{
+	public:
+		ReadsAOther(RunLog& log) : TestSystem(log) { Reads<ComponentA>(); }
+	};
+
+	class WritesA : public TestSystem
+	{
+	public:
+		WritesA(RunLog& log) : TestSystem(log) { Writes<ComponentA>(); }
+	};
+
+	class WritesB : public TestSystem
+	{
+	public:
+		WritesB(RunLog& log) : TestSystem(log) { Writes<ComponentB>(); }
+	};
+
+	class NoComponents : public TestSystem
+	{
+	public:
+		NoComponents(RunLog& log) : TestSystem(log) { SetExclusive(false); }
+	};
+
+	class Undeclared : public TestSystem
+	{
+	public:
+		Undeclared(RunLog& log) : TestSystem(log) {}
+	};
+}
+
+TEST_CASE("SystemManager Schedule", "[LumosEngine]")
+{
+	RunLog log;
+	SystemManager manager;
+
+	auto readsA = manager.RegisterSystem<ReadsA>(log);
+	auto writesB = manager.RegisterSystem<WritesB>(log);
+	auto readsAOther = manager.RegisterSystem<ReadsAOther>(log);
+	auto writesA = manager.RegisterSystem<WritesA>(log);
+	auto noComponents = manager.RegisterSystem<NoComponents>(log);
+
+	// Readers share a stage, the writer waits for both, the other systems don't conflict with anything
+	REQUIRE(manager.GetStageCount() == 2);
+	REQUIRE(manager.GetStage(0) == std::vector<ISystem*>{ readsA.get(), writesB.get(), readsAOther.get(), noComponents.get() });
+	REQUIRE(manager.GetStage(1) == std::vector<ISystem*>{ writesA.get() });
+
+	// An undeclared system conflicts with everything, so it runs on its own after all of them
+	auto undeclared = manager.RegisterSystem<Undeclared>(log);
+	REQUIRE(manager.GetStageCount() == 3);
+	REQUIRE(manager.GetStage(2) == std::vector<ISystem*>{ undeclared.get() });
+
+	manager.RemoveSystem<WritesA>();
+	REQUIRE(manager.GetStageCount() == 2);
+	REQUIRE(manager.GetStage(1) == std::vector<ISystem*>{ undeclared.get() });
+}
+
+TEST_CASE("SystemManager Update Order", "[LumosEngine]")
+{
+	RunLog log;
+	SystemManager manager;
+
+	auto readsA = manager.RegisterSystem<ReadsA>(log);
+	auto writesA = manager.RegisterSystem<WritesA>(log);
+	auto writesB = manager.RegisterSystem<WritesB>(log);
+	auto undeclared = manager.RegisterSystem<Undeclared>(log);
+	auto readsAOther = manager.RegisterSystem<ReadsAOther>(log);
+
+	// Only used as a key, OnUpdate never dereferences it
+	int sceneKey = 0;
+	Scene* scene = reinterpret_cast<Scene*>(&sceneKey);
+
+	for (int frame = 0; frame < 100; frame++)
+	{
+		log.counter = 0;
+		manager.OnUpdate(nullptr, scene);
+
+		// Every system ran once per frame
+		REQUIRE(log.counter == 5);
+
+		// Conflicting systems keep registration order
+		REQUIRE(readsA->GetRunIndex() < writesA->GetRunIndex());
+		REQUIRE(writesA->GetRunIndex() < undeclared->GetRunIndex());
+		REQUIRE(writesB->GetRunIndex() < undeclared->GetRunIndex());
+		REQUIRE(undeclared->GetRunIndex() < readsAOther->GetRunIndex());
+	}
+}
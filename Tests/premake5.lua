@@ -43,7 +43,8 @@ project "Tests"
 	{
 		--"LUMOS_DYNAMIC",
         "LUMOS_ROOT_DIR="  .. cwd,
-        "CATCH_CPP11_OR_GREATER"
+        "CATCH_CPP11_OR_GREATER",
+        "CATCH_CONFIG_ENABLE_BENCHMARKING"
 	}
 
 	filter "system:windows"
@@ -56,6 +57,7 @@ project "Tests"
 			"LUMOS_PLATFORM_WINDOWS",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_WIN32_KHR",
 			"WIN32_LEAN_AND_MEAN",
 			"_CRT_SECURE_NO_WARNINGS",
@@ -84,6 +86,7 @@ project "Tests"
 			"LUMOS_PLATFORM_UNIX",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_MACOS_MVK",
 			"LUMOS_IMGUI"
 		}
@@ -196,6 +199,7 @@ project "Tests"
 			"LUMOS_PLATFORM_UNIX",
 			"LUMOS_RENDER_API_OPENGL",
 			"LUMOS_RENDER_API_VULKAN",
+			"LUMOS_RENDER_API_NONE",
 			"VK_USE_PLATFORM_XCB_KHR",
 			"LUMOS_IMGUI"
 		}
@@ -1,6 +1,24 @@
 require 'Scripts/ios'
 require 'Scripts/premakeDefines'
 
+newoption
+{
+	trigger     = "no-sse",
+	description = "Build the Maths library without its SSE paths"
+}
+
+newoption
+{
+	trigger     = "simd",
+	value       = "LEVEL",
+	description = "Instruction set used by the Maths SSE paths",
+	allowed     =
+	{
+		{ "sse4.1", "SSE4.1 (default)" },
+		{ "avx2",   "AVX2 and FMA" }
+	}
+}
+
 workspace "Lumos"
 	architecture "x64"
 
@@ -13,6 +31,16 @@ workspace "Lumos"
 
 	startproject "Sandbox"
 
+	filter "options:no-sse"
+		defines { "LUMOS_NO_SSE" }
+
+	filter { "options:simd=avx2", "system:not ios", "toolset:not msc*" }
+		buildoptions { "-mavx2", "-mfma" }
+
+	filter { "options:simd=avx2", "toolset:msc*" }
+		buildoptions { "/arch:AVX2" }
+	filter()
+
 	location "build"
 
 	targetdir ("bin/%{cfg.longname}/")
@@ -32,6 +60,7 @@ workspace "Lumos"
 	require("Lumos/premake5")
 	require("Sandbox/premake5")
 	require("Tests/premake5")
+	require("Benchmark/premake5")
 	--require("Examples/premake5")
 
 	filter()